@@ -0,0 +1,48 @@
+/**
+ * @file atlas.h
+ * @brief Declaration of the texture atlas that holds every game sprite.
+ *
+ * The sprite sheets are copied at load time into one large bitmap and
+ * replaced by sub-bitmaps of it. Since every sprite then lives in the same
+ * texture, consecutive sprite draws inside al_hold_bitmap_drawing() are
+ * sent to the GPU as a single batch instead of one draw call each.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include <allegro5/allegro.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "types.h"
+
+/**
+ * @brief Structure representing a texture atlas.
+ */
+typedef struct _atlas ATLAS;
+
+/**
+ * @brief Creates an empty, fully transparent atlas of width x height pixels.
+ */
+ATLAS *atlas_create(int width, int height);
+
+/**
+ * @brief Destroys the atlas. Its sub-bitmaps must be destroyed first.
+ */
+STATUS atlas_destroy(ATLAS *atlas);
+
+/**
+ * @brief Copies a bitmap into the atlas and returns the sub-bitmap holding it.
+ */
+ALLEGRO_BITMAP *atlas_add(ATLAS *atlas, ALLEGRO_BITMAP *bitmap);
+
+/**
+ * @brief Reserves a transparent width x height region of the atlas.
+ */
+ALLEGRO_BITMAP *atlas_reserve(ATLAS *atlas, int width, int height);
+
+#endif /* ATLAS_H */
@@ -6,6 +6,9 @@
 #include <string.h>
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_primitives.h>
+#include "drawlist.h"
+#include "sprite.h"
+#include "fixed.h"
 #include "types.h"
 
 /**
@@ -13,10 +16,18 @@
  */
 typedef struct _bullet BULLET;
 
+/**
+ * @brief Identifies who fired a bullet.
+ */
+typedef enum {
+    BULLET_SHIP, ///< Fired by the player's ship
+    BULLET_MARTIAN ///< Fired by a martian
+} BULLET_OWNER;
+
 /**
  * @brief Creates a new bullet instance.
  */
-BULLET *bullet_create(ALLEGRO_BITMAP *bitmap, int width, int height, float x, float y, int dir);
+BULLET *bullet_create(SPRITE_ID sprite, FIXED x, FIXED y, int dir, BULLET_OWNER owner);
 
 /**
  * @brief Destroys a bullet and frees resources.
@@ -26,22 +37,22 @@ STATUS bullet_destroy(BULLET *bullet);
 /**
  * @brief Sets the x-coordinate of the bullet.
  */
-STATUS bullet_set_x(BULLET *bullet, float x);
+STATUS bullet_set_x(BULLET *bullet, FIXED x);
 
 /**
  * @brief Gets the x-coordinate of the bullet.
  */
-float bullet_get_x(BULLET *bullet);
+FIXED bullet_get_x(BULLET *bullet);
 
 /**
  * @brief Sets the y-coordinate of the bullet.
  */
-STATUS bullet_set_y(BULLET *bullet, float y);
+STATUS bullet_set_y(BULLET *bullet, FIXED y);
 
 /**
  * @brief Gets the y-coordinate of the bullet.
  */
-float bullet_get_y(BULLET *bullet);
+FIXED bullet_get_y(BULLET *bullet);
 
 /**
  * @brief Sets the direction of the bullet.
@@ -54,35 +65,20 @@ STATUS bullet_set_dir(BULLET *bullet, int dir);
 int bullet_get_dir(BULLET *bullet);
 
 /**
- * @brief Sets the bitmap for the bullet.
- */
-STATUS bullet_set_bitmap(BULLET *bullet, ALLEGRO_BITMAP *bitmap);
-
-/**
- * @brief Gets the bitmap of the bullet.
+ * @brief Gets who fired the bullet.
  */
-ALLEGRO_BITMAP *bullet_get_bitmap(BULLET *bullet);
+BULLET_OWNER bullet_get_owner(BULLET *bullet);
 
 /**
- * @brief Sets the x-coordinate of the bullet's source on the bitmap.
+ * @brief Sets the animation frame of the bullet.
  */
 STATUS bullet_set_source_x(BULLET *bullet, int source_x);
 
 /**
- * @brief Gets the x-coordinate of the bullet's source on the bitmap.
+ * @brief Gets the animation frame of the bullet.
  */
 int bullet_get_source_x(BULLET *bullet);
 
-/**
- * @brief Sets the y-coordinate of the bullet's source on the bitmap.
- */
-STATUS bullet_set_source_y(BULLET *bullet, int source_y);
-
-/**
- * @brief Gets the y-coordinate of the bullet's source on the bitmap.
- */
-int bullet_get_source_y(BULLET *bullet);
-
 /**
  * @brief Gets the width of the bullet.
  */
@@ -94,18 +90,13 @@ int bullet_get_width(BULLET *bullet);
 int bullet_get_height(BULLET *bullet);
 
 /**
- * @brief Renders the bullet to the screen.
+ * @brief Appends the bullet to a draw list.
  */
-STATUS bullet_print(BULLET *bullet);
+STATUS bullet_queue_draw(BULLET *bullet, DRAW_LIST *list, DRAW_LAYER layer);
 
 /**
  * @brief Moves the bullet based on its speed and direction.
  */
-STATUS bullet_move(BULLET *bullet, float speed);
-
-/**
- * @brief Checks for collision between the bullet and a specified object.
- */
-bool bullet_check_collision(BULLET *bullet, int obj_x, int obj_y, int obj_width, int obj_height);
+STATUS bullet_move(BULLET *bullet, FIXED speed);
 
 #endif /* BULLET_H */
\ No newline at end of file
@@ -0,0 +1,164 @@
+/**
+ * @file bullet_inline.h
+ * @brief In-tree view of BULLET: its structure and inline accessors.
+ *
+ * bullet.h keeps BULLET opaque for outside users. The game modules include
+ * this header instead, so the per-tick loops read bullet fields without a
+ * function call. The NULL checks are kept in debug builds only.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef BULLET_INLINE_H
+#define BULLET_INLINE_H
+
+#include "bullet.h"
+#include "check.h"
+#include "sprite_inline.h"
+
+struct _bullet {
+    FIXED x, y;                       ///< Bullet's x and y coordinates
+    FIXED prev_y;                     ///< Y-coordinate before the last move (start of the sweep)
+    uint8_t dir;                      ///< Bullet direction (UP or DOWN)
+    uint8_t owner;                    ///< Who fired the bullet (BULLET_OWNER)
+    uint8_t sprite;                   ///< Sprite descriptor (SPRITE_ID)
+    uint8_t source_x;                 ///< Animation frame (column in the sprite sheet)
+};
+
+/**
+ * @brief X-coordinate of the bullet.
+ */
+static inline FIXED bullet_x(const BULLET *bullet) {
+    CHECK_ARG(bullet, 0);
+    return bullet->x;
+}
+
+/**
+ * @brief Y-coordinate of the bullet.
+ */
+static inline FIXED bullet_y(const BULLET *bullet) {
+    CHECK_ARG(bullet, 0);
+    return bullet->y;
+}
+
+/**
+ * @brief Y-coordinate of the bullet before its last move.
+ */
+static inline FIXED bullet_prev_y(const BULLET *bullet) {
+    CHECK_ARG(bullet, 0);
+    return bullet->prev_y;
+}
+
+/**
+ * @brief Top of the area swept by the bullet during its last move.
+ */
+static inline FIXED bullet_sweep_y(const BULLET *bullet) {
+    CHECK_ARG(bullet, 0);
+    return bullet->y < bullet->prev_y ? bullet->y : bullet->prev_y;
+}
+
+/**
+ * @brief Who fired the bullet.
+ */
+static inline BULLET_OWNER bullet_owner(const BULLET *bullet) {
+    CHECK_ARG(bullet, BULLET_MARTIAN);
+    return (BULLET_OWNER)bullet->owner;
+}
+
+/**
+ * @brief Width of the bullet, from its sprite.
+ */
+static inline int bullet_width(const BULLET *bullet) {
+    CHECK_ARG(bullet, 0);
+    return sprite_width((SPRITE_ID)bullet->sprite);
+}
+
+/**
+ * @brief Height of the bullet, from its sprite.
+ */
+static inline int bullet_height(const BULLET *bullet) {
+    CHECK_ARG(bullet, 0);
+    return sprite_height((SPRITE_ID)bullet->sprite);
+}
+
+/**
+ * @brief Height of the area swept by the bullet during its last move, rounded up to pixels.
+ */
+static inline int bullet_sweep_height(const BULLET *bullet) {
+    CHECK_ARG(bullet, 0);
+    FIXED travel = bullet->y > bullet->prev_y ? bullet->y - bullet->prev_y
+                                              : bullet->prev_y - bullet->y;
+    return bullet_height(bullet) + FIXED_TO_INT(travel + FIXED_ONE - 1);
+}
+
+/**
+ * @brief Distance the bullet travelled in its last move before touching [top, bottom).
+ *
+ * Bullets only move vertically, so the entry point of a swept box is found
+ * on the y axis alone. Returns 0 if the bullet already touched the span
+ * before moving.
+ */
+static inline FIXED bullet_entry_distance(const BULLET *bullet, FIXED top, FIXED bottom) {
+    CHECK_ARG(bullet, 0);
+    FIXED distance;
+
+    if (bullet->y < bullet->prev_y) {
+        distance = bullet->prev_y - bottom;  // Moving up: our top meets their bottom
+    } else {
+        distance = top - (bullet->prev_y + INT_TO_FIXED(bullet_height(bullet)));
+    }
+
+    return distance > 0 ? distance : 0;
+}
+
+/**
+ * @brief Tests the area swept by the bullet in its last move against a box.
+ */
+static inline bool bullet_sweep_overlaps(const BULLET *bullet, FIXED x, FIXED y, int width,
+                                         int height) {
+    CHECK_ARG(bullet, false);
+    FIXED top = bullet_sweep_y(bullet);
+    FIXED bottom = (bullet->y > bullet->prev_y ? bullet->y : bullet->prev_y) +
+                   INT_TO_FIXED(bullet_height(bullet));
+
+    return bullet->x < x + INT_TO_FIXED(width) &&
+           bullet->x + INT_TO_FIXED(bullet_width(bullet)) > x &&
+           top < y + INT_TO_FIXED(height) && bottom > y;
+}
+
+/**
+ * @brief Tests whether two bullets met while both made their last move.
+ *
+ * Both bullets move at once, so the test runs on their relative vertical
+ * position, which changes linearly during the tick. On contact, *distance
+ * receives how far the first bullet had travelled when they met.
+ */
+static inline bool bullet_meets(const BULLET *bullet, const BULLET *other, FIXED *distance) {
+    CHECK_ARG(bullet && other && distance, false);
+    int64_t below = INT_TO_FIXED(bullet_height(other));   // Relative y at which bullet leaves other's bottom
+    int64_t above = -INT_TO_FIXED(bullet_height(bullet)); // Relative y at which bullet leaves other's top
+    int64_t d0 = (int64_t)bullet->prev_y - other->prev_y;
+    int64_t d1 = (int64_t)bullet->y - other->y;
+    int64_t travel = bullet->y > bullet->prev_y ? bullet->y - bullet->prev_y
+                                                : bullet->prev_y - bullet->y;
+
+    if (!(bullet->x < other->x + INT_TO_FIXED(bullet_width(other)) &&
+          bullet->x + INT_TO_FIXED(bullet_width(bullet)) > other->x) ||
+        (d0 < d1 ? d0 : d1) >= below || (d0 > d1 ? d0 : d1) <= above) {
+        return false;
+    }
+
+    // Fraction of the tick elapsed before the relative position entered (above, below)
+    if (d0 >= below) {
+        *distance = (FIXED)(travel * (d0 - below) / (d0 - d1));
+    } else if (d0 <= above) {
+        *distance = (FIXED)(travel * (above - d0) / (d1 - d0));
+    } else {
+        *distance = 0;
+    }
+
+    return true;
+}
+
+#endif /* BULLET_INLINE_H */
@@ -2,9 +2,10 @@
  * @file bunker.h
  * @brief Declaration of the Bunker structure and its associated functions.
  *
- * This header defines the structure and functions to manage individual bunker
- * parts in the Space Invaders game. Each bunker is composed of several parts,
- * each of which can take a fixed number of hits before being destroyed.
+ * This header defines the structure and functions to manage the bunkers of
+ * the Space Invaders game. Each bunker keeps a one-bit-per-pixel occupancy
+ * mask built from the bunker sprite. Hits erode the mask pixel by pixel and
+ * collisions test the mask bits under the bullet, as in the arcade.
  *
  * Author: RGiskard7
  * Date: 13/11/2024
@@ -15,38 +16,40 @@
 
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_primitives.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "config.h"
+#include "sprite.h"
+#include "fixed.h"
 #include "types.h"
 
 /**
- * @brief Structure representing a single part of a bunker.
+ * @brief Structure representing a bunker.
  *
- * Bunkers are composed of multiple parts, each rendered as a region of
- * the bunker sprite sheet. Each part tracks its own damage state.
+ * The shape of a bunker is an occupancy mask of BUNKER_WIDTH x
+ * BUNKER_HEIGHT bits, drawn through a sprite frame that is refreshed from
+ * the mask when it changes.
  */
 typedef struct _bunker BUNKER;
 
 /**
- * @brief Creates a new bunker part with the specified parameters.
+ * @brief Creates a new bunker with the specified parameters.
  *
- * @param bitmap Shared bitmap sprite sheet for all bunker parts.
- * @param source_x Initial x-coordinate in the sprite sheet (damage frame).
- * @param source_y Y-coordinate in the sprite sheet (part type/shape).
- * @param width Width of the bunker part.
- * @param height Height of the bunker part.
+ * @param sprite Sprite descriptor whose undamaged frames give the bunker shape.
+ * @param image Sprite whose frames hold the bunker images.
+ * @param frame Frame of image this bunker is drawn from.
  * @param x X-coordinate on screen.
  * @param y Y-coordinate on screen.
  * @return Pointer to the created BUNKER or NULL on failure.
  */
-BUNKER *bunker_create(ALLEGRO_BITMAP *bitmap, int source_x, int source_y,
-                      int width, int height, float x, float y);
+BUNKER *bunker_create(SPRITE_ID sprite, SPRITE_ID image, int frame, FIXED x, FIXED y);
 
 /**
- * @brief Destroys a bunker part and frees its memory.
+ * @brief Destroys a bunker and frees its memory.
  *
  * @param bunker Pointer to the BUNKER to destroy.
  * @return OK on success, ERROR if bunker is NULL.
@@ -54,52 +57,37 @@ BUNKER *bunker_create(ALLEGRO_BITMAP *bitmap, int source_x, int source_y,
 STATUS bunker_destroy(BUNKER *bunker);
 
 /**
- * @brief Gets the x-coordinate of the bunker part.
+ * @brief Gets the x-coordinate of the bunker.
  */
-float bunker_get_x(BUNKER *bunker);
+FIXED bunker_get_x(BUNKER *bunker);
 
 /**
- * @brief Gets the y-coordinate of the bunker part.
+ * @brief Gets the y-coordinate of the bunker.
  */
-float bunker_get_y(BUNKER *bunker);
+FIXED bunker_get_y(BUNKER *bunker);
 
 /**
- * @brief Gets the x-source coordinate in the sprite sheet (damage state).
+ * @brief Finds the first bunker row with solid pixels under a box.
  */
-int bunker_get_source_x(BUNKER *bunker);
+int bunker_hit_row(BUNKER *bunker, FIXED x, FIXED y, int width, int height, bool upward);
 
 /**
- * @brief Sets the x-source coordinate in the sprite sheet (damage state).
+ * @brief Erodes the bunker with the impact stamp centred on (x, y).
  */
-STATUS bunker_set_source_x(BUNKER *bunker, int source_x);
+STATUS bunker_erode(BUNKER *bunker, FIXED x, FIXED y);
 
 /**
- * @brief Gets the y-source coordinate in the sprite sheet (part shape).
+ * @brief Clears every bunker pixel under a box.
  */
-int bunker_get_source_y(BUNKER *bunker);
+STATUS bunker_erase(BUNKER *bunker, FIXED x, FIXED y, int width, int height);
 
 /**
- * @brief Gets the remaining life of the bunker part.
+ * @brief Rewrites the bunker image from the mask.
  */
-int bunker_get_life(BUNKER *bunker);
+STATUS bunker_write_image(BUNKER *bunker);
 
 /**
- * @brief Sets the remaining life of the bunker part.
- */
-STATUS bunker_set_life(BUNKER *bunker, int life);
-
-/**
- * @brief Gets the width of the bunker part.
- */
-int bunker_get_width(BUNKER *bunker);
-
-/**
- * @brief Gets the height of the bunker part.
- */
-int bunker_get_height(BUNKER *bunker);
-
-/**
- * @brief Renders the bunker part on the screen.
+ * @brief Renders the bunker on the screen.
  */
 STATUS bunker_print(BUNKER *bunker);
 
@@ -0,0 +1,54 @@
+/**
+ * @file bunker_inline.h
+ * @brief In-tree view of BUNKER: its structure and inline accessors.
+ *
+ * bunker.h keeps BUNKER opaque for outside users. The game modules include
+ * this header to read bunker fields without a function call. The NULL
+ * checks are kept in debug builds only.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef BUNKER_INLINE_H
+#define BUNKER_INLINE_H
+
+#include "bunker.h"
+#include "check.h"
+
+/**
+ * @struct _bunker
+ * @brief Represents a destructible bunker shield.
+ *
+ * Each row of the bunker is one 64-bit word of its occupancy mask, bit x
+ * standing for pixel column x, so a whole row is tested or eroded with a
+ * single AND. The image only mirrors the mask for drawing and is
+ * rewritten when the mask has changed since the last frame. It is one
+ * frame of a sprite shared by all bunkers, so bunkers draw like any other
+ * sprite.
+ */
+struct _bunker {
+    FIXED x, y;                     ///< Screen coordinates of the bunker
+    uint64_t rows[BUNKER_HEIGHT];   ///< Occupancy mask, one word per pixel row
+    uint8_t image;                  ///< Sprite holding the bunker image (SPRITE_ID)
+    uint8_t frame;                  ///< Column of that sprite rebuilt from the mask
+    uint32_t pixel;                 ///< Colour of a solid pixel (ABGR_8888)
+};
+
+/**
+ * @brief X-coordinate of the bunker.
+ */
+static inline FIXED bunker_x(const BUNKER *bunker) {
+    CHECK_ARG(bunker, 0);
+    return bunker->x;
+}
+
+/**
+ * @brief Y-coordinate of the bunker.
+ */
+static inline FIXED bunker_y(const BUNKER *bunker) {
+    CHECK_ARG(bunker, 0);
+    return bunker->y;
+}
+
+#endif /* BUNKER_INLINE_H */
@@ -0,0 +1,27 @@
+/**
+ * @file check.h
+ * @brief Argument checks for the inline accessors.
+ *
+ * CHECK_ARG(cond, ret) returns ret from the enclosing function when cond
+ * is false. Debug builds keep the check; release builds (-DNDEBUG) compile
+ * it out, so an inline accessor reduces to a single load.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef CHECK_H
+#define CHECK_H
+
+#ifdef NDEBUG
+#define CHECK_ARG(cond, ret) ((void)0)
+#else
+#define CHECK_ARG(cond, ret)                                                   \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      return (ret);                                                            \
+    }                                                                          \
+  } while (0)
+#endif
+
+#endif /* CHECK_H */
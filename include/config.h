@@ -24,6 +24,7 @@
 #define UFO_IMG_RSC "resources/images/ovni.png"  // fallback, not used when UFO_EMBEDDED is 1
 #define UFO_EMBEDDED 1    ///< Use hardcoded pixel sprite instead of loading PNG
 #define FONT_RSC "resources/fonts/space_invaders.ttf"
+#define ATLAS_SIZE 256    ///< Side of the texture atlas holding every sprite
 
 // Sound Resources
 #define SND_SHOOT "resources/sounds/shoot.wav"
@@ -58,6 +59,12 @@
   DISPLAY_WIDTH - FRAME_WIDTH ///< Width of the playable canvas area
 #define RIGHT_MARGIN 32 ///< Right boundary offset for ship and enemy movement
 
+// Transparent window of frame.bmp; sprites are clipped to it
+#define FRAME_WINDOW_X 39       ///< Left edge of the window
+#define FRAME_WINDOW_Y 112      ///< Top edge of the window
+#define FRAME_WINDOW_WIDTH 518  ///< Width of the window
+#define FRAME_WINDOW_HEIGHT 445 ///< Height of the window
+
 // Gameplay Modes
 #define GOD_MODE 0 ///< Toggle for invincibility mode (0 = off, 1 = on)
 
@@ -74,9 +81,9 @@
 #define SHIP_EXPLOSION_FRAMES 60   ///< Duration of ship explosion animation in frames
 
 // MARTIANS CONFIGURATION
-#define MAX_ENEMIES 55 ///< Maximum number of enemies
 #define NUM_ENEMY_X 11 ///< Number of martians per row
 #define NUM_ENEMY_Y 5  ///< Number of martians per column
+#define MAX_ENEMIES (NUM_ENEMY_X * NUM_ENEMY_Y) ///< Cells of the formation (for sizing)
 
 #define SPACE_BTW_MARTIANS_X 32 ///< Horizontal space between martians
 #define SPACE_BTW_MARTIANS_Y 27 ///< Vertical space between martians
@@ -103,9 +110,8 @@
 // BULLETS CONFIGURATION
 #define BULLET_WIDTH 6
 #define BULLET_HEIGHT 12
-#define MAX_ORP_BULLETS                                                        \
-  20 ///< Maximum number of orphan bullets (bullets not associated with any ship
-     ///< or martian)
+#define MAX_BULLETS                                                            \
+  32 ///< Maximum number of bullets in flight (player and martians together)
 
 // OBJECT CONFIGURATION
 #define OBJECT_TIMER                                                           \
@@ -135,11 +141,21 @@
 
 // BUNKERS CONFIGURATION
 #define NUM_BUNKERS 4
-#define BUNKER_PARTS 5       ///< Number of sprite parts per bunker
-#define BUNKER_PART_WIDTH 20
-#define BUNKER_PART_HEIGHT 16
+#define BUNKER_PART_WIDTH 20  ///< Frame width in the bunker sprite sheet
+#define BUNKER_PART_HEIGHT 16 ///< Frame height in the bunker sprite sheet
+#define BUNKER_WIDTH (3 * BUNKER_PART_WIDTH)  ///< Bunker width in pixels (3 parts)
+#define BUNKER_HEIGHT (2 * BUNKER_PART_HEIGHT) ///< Bunker height in pixels (2 parts)
 #define BUNKER_INIT_POS_Y DISPLAY_HEIGHT - 160
-#define BUNKER_LIFE 3 ///< 3 states (frames), 1 hit per state
+
+// COLLISION BROADPHASE
+#define GRID_CELL_SIZE 32 ///< Side of a collision grid cell in pixels
+
+// DIRTY RECTANGLES (memory-bitmap display path)
+#define DIRTY_TILE_SIZE 16   ///< Side of a dirty-map tile in pixels
+#define DIRTY_MAX_RECTS 48   ///< Above this many rectangles the whole screen is redrawn
+
+// MEMORY LAYOUT
+#define CACHE_LINE_SIZE 64 ///< Alignment of the per-tick game state
 
 // TOP SCORE TABLE
 #define TOP_SCORES_FILE "highscores.dat"
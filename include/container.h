@@ -0,0 +1,231 @@
+/**
+ * @file container.h
+ * @brief Type-generic, fixed-capacity containers generated by macros.
+ *
+ * Three containers cover every list in the game:
+ *
+ * - DEFINE_DENSE_LIST: an unordered packed array. Push appends; removal
+ *   moves the last item into the hole, so both take constant time and
+ *   iteration is a plain loop over items[0..size).
+ * - DEFINE_RING_BUFFER: a FIFO queue over a circular array.
+ * - DEFINE_MIN_HEAP: a priority queue (binary heap) that pops its smallest
+ *   item first; push and pop take logarithmic time.
+ *
+ * The storage is provided by the caller (a static array or a block from
+ * malloc), so a container never allocates. All functions are static inline
+ * and expand once per element type, e.g.
+ *
+ *   DEFINE_DENSE_LIST(INT_LIST, int_list, int)
+ *
+ * declares the INT_LIST type and int_list_init(), int_list_push(), ...
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef CONTAINER_H
+#define CONTAINER_H
+
+#include <stdbool.h>
+
+#include "types.h"
+
+/**
+ * @brief Declares a dense list type LIST of TYPE and its prefix_* functions.
+ *
+ * - prefix_init(list, storage, capacity): empties the list over storage.
+ * - prefix_push(list, item): appends item; ERROR when full.
+ * - prefix_at(list, i): pointer to item i (i must be in [0, size)).
+ * - prefix_remove_at(list, i): removes item i by moving the last item into
+ *   its place and returns the removed item.
+ * - prefix_clear(list), prefix_size(list), prefix_is_full(list).
+ */
+#define DEFINE_DENSE_LIST(LIST, prefix, TYPE)                                  \
+  typedef struct {                                                             \
+    TYPE *items;  /* Packed items, valid in [0, size) */                       \
+    int size;     /* Number of items */                                        \
+    int capacity; /* Number of items the storage can hold */                   \
+  } LIST;                                                                      \
+                                                                               \
+  static inline void prefix##_init(LIST *list, TYPE *storage, int capacity) {  \
+    list->items = storage;                                                     \
+    list->size = 0;                                                            \
+    list->capacity = capacity;                                                 \
+  }                                                                            \
+                                                                               \
+  static inline STATUS prefix##_push(LIST *list, TYPE item) {                  \
+    if (list->size >= list->capacity) {                                        \
+      return ERROR;                                                            \
+    }                                                                          \
+    list->items[list->size++] = item;                                          \
+    return OK;                                                                 \
+  }                                                                            \
+                                                                               \
+  static inline TYPE *prefix##_at(LIST *list, int i) {                         \
+    return &list->items[i];                                                    \
+  }                                                                            \
+                                                                               \
+  static inline TYPE prefix##_remove_at(LIST *list, int i) {                   \
+    TYPE item = list->items[i];                                                \
+    list->items[i] = list->items[--list->size];                                \
+    return item;                                                               \
+  }                                                                            \
+                                                                               \
+  static inline void prefix##_clear(LIST *list) { list->size = 0; }            \
+                                                                               \
+  static inline int prefix##_size(const LIST *list) { return list->size; }     \
+                                                                               \
+  static inline bool prefix##_is_full(const LIST *list) {                      \
+    return list->size >= list->capacity;                                       \
+  }
+
+/**
+ * @brief Declares a ring buffer type RING of TYPE and its prefix_* functions.
+ *
+ * - prefix_init(ring, storage, capacity): empties the queue over storage.
+ * - prefix_push(ring, item): enqueues item at the tail; ERROR when full.
+ * - prefix_pop(ring, &item): dequeues the oldest item; ERROR when empty.
+ * - prefix_clear(ring), prefix_size(ring), prefix_is_empty(ring),
+ *   prefix_is_full(ring).
+ */
+#define DEFINE_RING_BUFFER(RING, prefix, TYPE)                                 \
+  typedef struct {                                                             \
+    TYPE *items;  /* Circular storage */                                       \
+    int head;     /* Position of the oldest item */                            \
+    int count;    /* Number of queued items */                                 \
+    int capacity; /* Number of items the storage can hold */                   \
+  } RING;                                                                      \
+                                                                               \
+  static inline void prefix##_init(RING *ring, TYPE *storage, int capacity) {  \
+    ring->items = storage;                                                     \
+    ring->head = 0;                                                            \
+    ring->count = 0;                                                           \
+    ring->capacity = capacity;                                                 \
+  }                                                                            \
+                                                                               \
+  static inline STATUS prefix##_push(RING *ring, TYPE item) {                  \
+    int tail;                                                                  \
+    if (ring->count >= ring->capacity) {                                       \
+      return ERROR;                                                            \
+    }                                                                          \
+    tail = ring->head + ring->count;                                           \
+    if (tail >= ring->capacity) {                                              \
+      tail -= ring->capacity;                                                  \
+    }                                                                          \
+    ring->items[tail] = item;                                                  \
+    ring->count++;                                                             \
+    return OK;                                                                 \
+  }                                                                            \
+                                                                               \
+  static inline STATUS prefix##_pop(RING *ring, TYPE *item) {                  \
+    if (ring->count == 0) {                                                    \
+      return ERROR;                                                            \
+    }                                                                          \
+    *item = ring->items[ring->head];                                           \
+    if (++ring->head == ring->capacity) {                                      \
+      ring->head = 0;                                                          \
+    }                                                                          \
+    ring->count--;                                                             \
+    return OK;                                                                 \
+  }                                                                            \
+                                                                               \
+  static inline void prefix##_clear(RING *ring) {                              \
+    ring->head = 0;                                                            \
+    ring->count = 0;                                                           \
+  }                                                                            \
+                                                                               \
+  static inline int prefix##_size(const RING *ring) { return ring->count; }    \
+                                                                               \
+  static inline bool prefix##_is_empty(const RING *ring) {                     \
+    return ring->count == 0;                                                   \
+  }                                                                            \
+                                                                               \
+  static inline bool prefix##_is_full(const RING *ring) {                      \
+    return ring->count >= ring->capacity;                                      \
+  }
+
+/**
+ * @brief Declares a binary min-heap type HEAP of TYPE and its prefix_* functions.
+ *
+ * LESS(a, b) compares two items through pointers and returns true if *a
+ * must be popped before *b.
+ *
+ * - prefix_init(heap, storage, capacity): empties the heap over storage.
+ * - prefix_push(heap, item): inserts item; ERROR when full.
+ * - prefix_top(heap): pointer to the smallest item (heap must not be empty).
+ * - prefix_pop(heap, &item): removes the smallest item; ERROR when empty.
+ * - prefix_clear(heap), prefix_size(heap), prefix_is_empty(heap),
+ *   prefix_is_full(heap).
+ */
+#define DEFINE_MIN_HEAP(HEAP, prefix, TYPE, LESS)                              \
+  typedef struct {                                                             \
+    TYPE *items;  /* Heap-ordered items, valid in [0, size) */                 \
+    int size;     /* Number of items */                                        \
+    int capacity; /* Number of items the storage can hold */                   \
+  } HEAP;                                                                      \
+                                                                               \
+  static inline void prefix##_init(HEAP *heap, TYPE *storage, int capacity) {  \
+    heap->items = storage;                                                     \
+    heap->size = 0;                                                            \
+    heap->capacity = capacity;                                                 \
+  }                                                                            \
+                                                                               \
+  static inline STATUS prefix##_push(HEAP *heap, TYPE item) {                  \
+    int i;                                                                     \
+    if (heap->size >= heap->capacity) {                                        \
+      return ERROR;                                                            \
+    }                                                                          \
+    /* Sift up: move parents down until item fits */                           \
+    for (i = heap->size++; i > 0; i = (i - 1) / 2) {                           \
+      if (!LESS(&item, &heap->items[(i - 1) / 2])) {                           \
+        break;                                                                 \
+      }                                                                        \
+      heap->items[i] = heap->items[(i - 1) / 2];                               \
+    }                                                                          \
+    heap->items[i] = item;                                                     \
+    return OK;                                                                 \
+  }                                                                            \
+                                                                               \
+  static inline TYPE *prefix##_top(HEAP *heap) { return &heap->items[0]; }     \
+                                                                               \
+  static inline STATUS prefix##_pop(HEAP *heap, TYPE *item) {                  \
+    TYPE last;                                                                 \
+    int i = 0;                                                                 \
+    if (heap->size == 0) {                                                     \
+      return ERROR;                                                            \
+    }                                                                          \
+    *item = heap->items[0];                                                    \
+    last = heap->items[--heap->size];                                          \
+    /* Sift down: move the smaller child up until the last item fits */        \
+    for (;;) {                                                                 \
+      int child = 2 * i + 1;                                                   \
+      if (child >= heap->size) {                                               \
+        break;                                                                 \
+      }                                                                        \
+      if (child + 1 < heap->size &&                                            \
+          LESS(&heap->items[child + 1], &heap->items[child])) {                \
+        child++;                                                               \
+      }                                                                        \
+      if (!LESS(&heap->items[child], &last)) {                                 \
+        break;                                                                 \
+      }                                                                        \
+      heap->items[i] = heap->items[child];                                     \
+      i = child;                                                               \
+    }                                                                          \
+    heap->items[i] = last;                                                     \
+    return OK;                                                                 \
+  }                                                                            \
+                                                                               \
+  static inline void prefix##_clear(HEAP *heap) { heap->size = 0; }            \
+                                                                               \
+  static inline int prefix##_size(const HEAP *heap) { return heap->size; }     \
+                                                                               \
+  static inline bool prefix##_is_empty(const HEAP *heap) {                     \
+    return heap->size == 0;                                                    \
+  }                                                                            \
+                                                                               \
+  static inline bool prefix##_is_full(const HEAP *heap) {                      \
+    return heap->size >= heap->capacity;                                       \
+  }
+
+#endif /* CONTAINER_H */
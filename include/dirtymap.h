@@ -0,0 +1,78 @@
+/**
+ * @file dirtymap.h
+ * @brief Declaration of the map of screen areas to redraw.
+ *
+ * The screen is divided into square tiles and every area that changed
+ * marks the tiles it touches. The marked tiles are then merged into a few
+ * rectangles, so only those parts of the screen are redrawn and presented.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef DIRTYMAP_H
+#define DIRTYMAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "types.h"
+
+#define DIRTYMAP_MAX_COLS 64 ///< Each row of tiles is one 64-bit word
+
+/**
+ * @brief Rectangle of the screen, in pixels.
+ */
+typedef struct {
+  int x, y; ///< Top-left corner
+  int w, h; ///< Size
+} DIRTY_RECT;
+
+/**
+ * @brief Structure representing a dirty map.
+ */
+typedef struct _dirtymap DIRTY_MAP;
+
+/**
+ * @brief Creates a map with no dirty tile.
+ */
+DIRTY_MAP *dirtymap_create(int width, int height, int tile_size);
+
+/**
+ * @brief Destroys the map and frees its memory.
+ */
+STATUS dirtymap_destroy(DIRTY_MAP *map);
+
+/**
+ * @brief Marks every tile as clean.
+ */
+STATUS dirtymap_clear(DIRTY_MAP *map);
+
+/**
+ * @brief Marks the tiles overlapped by a box as dirty.
+ */
+STATUS dirtymap_mark(DIRTY_MAP *map, int x, int y, int width, int height);
+
+/**
+ * @brief Marks every tile as dirty.
+ */
+STATUS dirtymap_mark_all(DIRTY_MAP *map);
+
+/**
+ * @brief Marks as dirty every tile that is dirty in another map of the same size.
+ */
+STATUS dirtymap_merge(DIRTY_MAP *map, const DIRTY_MAP *other);
+
+/**
+ * @brief Whether no tile is dirty.
+ */
+bool dirtymap_is_clean(const DIRTY_MAP *map);
+
+/**
+ * @brief Covers the dirty tiles with rectangles.
+ */
+int dirtymap_rects(DIRTY_MAP *map, const DIRTY_RECT **rects);
+
+#endif /* DIRTYMAP_H */
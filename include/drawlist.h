@@ -0,0 +1,99 @@
+/**
+ * @file drawlist.h
+ * @brief Declaration of the retained list of sprite draw commands.
+ *
+ * At the end of each tick the game records every sprite to show as a
+ * small command: layer, sprite, frame and position. Rendering then only
+ * replays the list, turning it into textured quads that are sent with one
+ * al_draw_prims() call per texture. Since the list is plain data, it can
+ * be built away from the Allegro calls or kept to replay a frame.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_primitives.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fixed.h"
+#include "sprite.h"
+#include "types.h"
+
+/**
+ * @brief Drawing order of the sprites, back to front.
+ */
+typedef enum {
+  LAYER_MARTIANS, ///< Martian formation
+  LAYER_BUNKERS,  ///< Bunkers
+  LAYER_SHIP,     ///< Player ship
+  LAYER_UFO,      ///< Mystery ship
+  LAYER_BULLETS,  ///< Bullets of both sides
+  LAYER_EFFECTS,  ///< Explosions
+  LAYER_HUD,      ///< Life icons
+  NUM_LAYERS
+} DRAW_LAYER;
+
+/**
+ * @brief One sprite to draw.
+ */
+typedef struct {
+  uint8_t layer;   ///< DRAW_LAYER
+  uint8_t sprite;  ///< SPRITE_ID
+  uint8_t frame_x; ///< Column of the frame in the sprite sheet
+  uint8_t frame_y; ///< Row of the frame in the sprite sheet
+  FIXED x, y;      ///< Screen coordinates
+} DRAW_CMD;
+
+/**
+ * @brief Structure representing a draw list.
+ */
+typedef struct _drawlist DRAW_LIST;
+
+/**
+ * @brief Creates an empty draw list able to hold capacity commands.
+ */
+DRAW_LIST *drawlist_create(int capacity);
+
+/**
+ * @brief Destroys the draw list.
+ */
+STATUS drawlist_destroy(DRAW_LIST *list);
+
+/**
+ * @brief Removes every command from the list.
+ */
+STATUS drawlist_clear(DRAW_LIST *list);
+
+/**
+ * @brief Appends a command to the list.
+ */
+STATUS drawlist_push(DRAW_LIST *list, DRAW_LAYER layer, SPRITE_ID sprite, int frame_x, int frame_y,
+                     FIXED x, FIXED y);
+
+/**
+ * @brief Gets the number of commands in the list.
+ */
+int drawlist_size(const DRAW_LIST *list);
+
+/**
+ * @brief Gets the command at position i.
+ */
+const DRAW_CMD *drawlist_at(const DRAW_LIST *list, int i);
+
+/**
+ * @brief Sorts the commands by layer, then by sprite.
+ */
+STATUS drawlist_sort(DRAW_LIST *list);
+
+/**
+ * @brief Draws every command, one al_draw_prims() call per run of the same texture.
+ */
+STATUS drawlist_submit(DRAW_LIST *list);
+
+#endif /* DRAWLIST_H */
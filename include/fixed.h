@@ -0,0 +1,42 @@
+/**
+ * @file fixed.h
+ * @brief 16.16 fixed-point coordinates shared by every entity module.
+ *
+ * Positions and speeds are stored as FIXED: a signed 32-bit integer whose
+ * low 16 bits hold the fraction of a pixel. Simulation and collision tests
+ * use integer arithmetic only, so a game replays bit-exactly whatever the
+ * compiler or the floating-point flags. Values are converted to float only
+ * when they reach Allegro's drawing functions.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+/**
+ * @brief 16.16 fixed-point number (1 pixel = FIXED_ONE).
+ */
+typedef int32_t FIXED;
+
+#define FIXED_SHIFT 16                      ///< Bits of the fractional part
+#define FIXED_ONE ((FIXED)1 << FIXED_SHIFT) ///< One pixel
+#define FIXED_MAX INT32_MAX                 ///< Largest representable value
+
+/** @brief Converts a whole number of pixels to FIXED. */
+#define INT_TO_FIXED(v) ((FIXED)(v) * FIXED_ONE)
+
+/** @brief Converts FIXED to whole pixels, rounding towards minus infinity. */
+#define FIXED_TO_INT(v) ((int)((v) >> FIXED_SHIFT))
+
+/** @brief Converts a float to FIXED, rounding to the nearest value. */
+#define FLOAT_TO_FIXED(v)                                                      \
+  ((FIXED)((v) * FIXED_ONE + ((v) < 0 ? -0.5f : 0.5f)))
+
+/** @brief Converts FIXED to float, for drawing only. */
+#define FIXED_TO_FLOAT(v) ((float)(v) / FIXED_ONE)
+
+#endif /* FIXED_H */
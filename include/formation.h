@@ -0,0 +1,196 @@
+/**
+ * @file formation.h
+ * @brief Declaration of the Formation structure and its associated functions.
+ *
+ * The martians never move on their own: the whole invasion fleet steps as a
+ * single block. The formation therefore stores one (x, y) offset plus a
+ * packed grid of alive cells, and every martian position is derived on
+ * demand from its cell index. Cells are numbered row-major, so cell
+ * i = row * cols + col.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef FORMATION_H
+#define FORMATION_H
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_primitives.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "config.h"
+#include "drawlist.h"
+#include "fixed.h"
+#include "types.h"
+
+#define MART_WIDTH 25
+#define MART_HEIGHT 20
+#define MAX_FORMATION_ROWS 64 ///< One bit per row in the column alive masks
+
+/**
+ * @brief Structure representing the whole martian formation.
+ */
+typedef struct _formation FORMATION;
+
+/**
+ * @brief Creates a new formation of cols x rows martians (size from SPRITE_MARTIAN).
+ *
+ * @param cols Number of martians per row.
+ * @param rows Number of martians per column.
+ * @return Pointer to the created FORMATION or NULL on failure.
+ */
+FORMATION *form_create(int cols, int rows);
+
+/**
+ * @brief Destroys the formation and frees its memory.
+ */
+STATUS form_destroy(FORMATION *formation);
+
+/**
+ * @brief Revives every cell and places the formation at (x, y).
+ */
+STATUS form_reset(FORMATION *formation, FIXED x, FIXED y);
+
+/**
+ * @brief Sets the x-coordinate of the formation origin.
+ */
+STATUS form_set_x(FORMATION *formation, FIXED x);
+
+/**
+ * @brief Gets the x-coordinate of the formation origin.
+ */
+FIXED form_get_x(FORMATION *formation);
+
+/**
+ * @brief Sets the y-coordinate of the formation origin.
+ */
+STATUS form_set_y(FORMATION *formation, FIXED y);
+
+/**
+ * @brief Gets the y-coordinate of the formation origin.
+ */
+FIXED form_get_y(FORMATION *formation);
+
+/**
+ * @brief Sets the movement direction of the formation.
+ */
+STATUS form_set_dir(FORMATION *formation, int dir);
+
+/**
+ * @brief Gets the movement direction of the formation.
+ */
+int form_get_dir(FORMATION *formation);
+
+/**
+ * @brief Gets the number of martians per row.
+ */
+int form_get_cols(FORMATION *formation);
+
+/**
+ * @brief Gets the number of martians per column.
+ */
+int form_get_rows(FORMATION *formation);
+
+/**
+ * @brief Gets the total number of cells (cols * rows).
+ */
+int form_get_size(FORMATION *formation);
+
+/**
+ * @brief Checks if the martian in cell i is alive.
+ */
+bool form_is_alive(FORMATION *formation, int i);
+
+/**
+ * @brief Marks the martian in cell i as dead.
+ */
+STATUS form_kill(FORMATION *formation, int i);
+
+/**
+ * @brief Checks if every martian of the formation is dead.
+ */
+bool form_is_empty(FORMATION *formation);
+
+/**
+ * @brief Gets the x-coordinate of the leftmost live column.
+ */
+FIXED form_get_left(FORMATION *formation);
+
+/**
+ * @brief Gets the x-coordinate of the rightmost live column.
+ */
+FIXED form_get_right(FORMATION *formation);
+
+/**
+ * @brief Gets the y-coordinate of the lowest live row.
+ */
+FIXED form_get_bottom(FORMATION *formation);
+
+/**
+ * @brief Gets the front (lowest alive) martian of a column, or -1.
+ */
+int form_get_front_cell(FORMATION *formation, int col);
+
+/**
+ * @brief Picks a random front-row martian in constant time, or -1.
+ */
+int form_get_random_shooter(FORMATION *formation, int rand_value);
+
+/**
+ * @brief Finds the alive martian overlapped by a box in constant time, or -1.
+ */
+int form_hit_test(FORMATION *formation, FIXED x, FIXED y, int width, int height);
+
+/**
+ * @brief Gets the screen x-coordinate of cell i.
+ */
+FIXED form_get_cell_x(FORMATION *formation, int i);
+
+/**
+ * @brief Gets the screen y-coordinate of cell i.
+ */
+FIXED form_get_cell_y(FORMATION *formation, int i);
+
+/**
+ * @brief Gets the score awarded for destroying the martian in cell i.
+ */
+int form_get_cell_score(FORMATION *formation, int i);
+
+/**
+ * @brief Sets the shared animation frame of all martians.
+ */
+STATUS form_set_source_x(FORMATION *formation, int source_x);
+
+/**
+ * @brief Gets the shared animation frame of all martians.
+ */
+int form_get_source_x(FORMATION *formation);
+
+/**
+ * @brief Gets the width of a martian.
+ */
+int form_get_width(FORMATION *formation);
+
+/**
+ * @brief Gets the height of a martian.
+ */
+int form_get_height(FORMATION *formation);
+
+/**
+ * @brief Moves the whole formation one step in its current direction.
+ *
+ * Only the formation origin changes, so a step costs the same regardless
+ * of the number of martians.
+ */
+STATUS form_move(FORMATION *formation, FIXED speed);
+
+/**
+ * @brief Appends every alive martian of the formation to a draw list.
+ */
+STATUS form_queue_draw(FORMATION *formation, DRAW_LIST *list, DRAW_LAYER layer);
+
+#endif /* FORMATION_H */
@@ -0,0 +1,71 @@
+/**
+ * @file formation_inline.h
+ * @brief In-tree view of FORMATION: its structure and inline cell lookups.
+ *
+ * formation.h keeps FORMATION opaque for outside users. The game modules
+ * include this header so the per-tick loops over the cells read the alive
+ * masks and the origin without a function call. The argument checks are
+ * kept in debug builds only.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef FORMATION_INLINE_H
+#define FORMATION_INLINE_H
+
+#include "check.h"
+#include "container.h"
+#include "formation.h"
+
+DEFINE_DENSE_LIST(COLUMN_LIST, column_list, int)
+
+/**
+ * @struct _formation
+ * @brief Represents the block of martians moving together.
+ *
+ * Stores the origin of the block, its direction, the shared sprite sheet
+ * and animation frame, and the alive state of every cell. Bit r of
+ * col_mask[c] is set while the martian at (c, r) is alive. The columns
+ * that still hold martians are kept in a dense list so a random shooter
+ * can be picked without scanning the grid, and the bounding box of the
+ * live martians shrinks as edge columns and bottom rows are emptied.
+ */
+struct _formation {
+  FIXED x, y;             ///< Screen coordinates of cell 0 (top-left martian)
+  int dir;                ///< Current movement direction
+  int source_x;           ///< Shared animation frame in the sprite sheet
+  int cols, rows;         ///< Grid dimensions
+  uint64_t *col_mask;     ///< Alive bitmask per column (bit = row)
+  COLUMN_LIST live_cols;  ///< Dense list of columns with at least one martian
+  int *live_col_pos;      ///< Position of each column in live_cols (-1 if empty)
+  int *row_count;         ///< Number of live martians per row
+  int min_col, max_col;   ///< Leftmost and rightmost non-empty columns
+  int max_row;            ///< Lowest non-empty row
+};
+
+/**
+ * @brief Whether the martian in cell i is alive (unchecked in release builds).
+ */
+static inline bool form_cell_alive(const FORMATION *formation, int i) {
+  CHECK_ARG(formation && i >= 0 && i < formation->cols * formation->rows, false);
+  return (formation->col_mask[i % formation->cols] >> (i / formation->cols)) & 1;
+}
+
+/**
+ * @brief Screen x-coordinate of cell i.
+ */
+static inline FIXED form_cell_x(const FORMATION *formation, int i) {
+  CHECK_ARG(formation, 0);
+  return formation->x + INT_TO_FIXED((i % formation->cols) * SPACE_BTW_MARTIANS_X);
+}
+
+/**
+ * @brief Screen y-coordinate of cell i.
+ */
+static inline FIXED form_cell_y(const FORMATION *formation, int i) {
+  CHECK_ARG(formation, 0);
+  return formation->y + INT_TO_FIXED((i / formation->cols) * SPACE_BTW_MARTIANS_Y);
+}
+
+#endif /* FORMATION_INLINE_H */
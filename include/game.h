@@ -13,13 +13,30 @@
 #include "config.h"
 #include "types.h"
 #include "ship.h"
-#include "martian.h"
+#include "formation.h"
 #include "bullet.h"
 #include "object.h"
 #include "bunker.h"
+#include "grid.h"
+#include "slotmap.h"
+#include "sprite.h"
 
 typedef struct _game GAME;
 
+/**
+ * @brief Player input of one tick, independent of the input device.
+ *
+ * main.c fills it in from the keyboard; headless runs script it.
+ */
+typedef struct {
+  bool left, right; ///< Move the ship, or the initials cursor
+  bool up, down;    ///< Change the letter of the initials being entered
+  bool fire;        ///< Shoot
+  bool enter;       ///< Start, go on to the next screen or confirm initials
+  bool pause;       ///< Pause (toggles when pressed)
+  bool escape;      ///< Quit, or leave the initials entry
+} GAME_INPUT;
+
 /**
  * @brief Creates a new game instance.
  */
@@ -30,6 +47,11 @@ GAME *game_create();
  */
 STATUS game_init(GAME *game, float FPS);
 
+/**
+ * @brief Initializes only the simulation, without display or media (headless runs).
+ */
+STATUS game_init_headless(GAME *game);
+
 /**
  * @brief Destroys the game and frees resources.
  */
@@ -60,16 +82,56 @@ ALLEGRO_EVENT *game_get_event(GAME *game);
  */
 STATUS game_set_rand_enemy(GAME *game, int lastrand);
 
+/**
+ * @brief Seeds the game's random sequence.
+ */
+STATUS game_set_seed(GAME *game, unsigned seed);
+
+/**
+ * @brief Enables or disables sound playback (disable it for headless runs).
+ */
+STATUS game_set_audio(GAME *game, bool enabled);
+
+/**
+ * @brief Enables or disables saving scores to disk (disable it for headless runs).
+ */
+STATUS game_set_persistence(GAME *game, bool enabled);
+
+/**
+ * @brief Enables or disables the dirty-rectangle renderer (for memory-bitmap displays).
+ */
+STATUS game_set_dirty_rects(GAME *game, bool enabled);
+
 /**
  * @brief Updates the game state.
  */
-STATUS game_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key);
+STATUS game_update(GAME *game, const GAME_INPUT *input);
+
+/**
+ * @brief Skips the upcoming ticks in which nothing observable happens (headless runs).
+ */
+int game_skip_quiet_ticks(GAME *game, const GAME_INPUT *input, int max_ticks);
 
 /**
- * @brief Renders the game to the display.
+ * @brief Hashes the simulation state (compares headless runs).
+ */
+uint64_t game_state_hash(GAME *game);
+
+/**
+ * @brief Renders the game to the display, or hands the frame to the render thread.
  */
 STATUS game_render(GAME *game);
 
+/**
+ * @brief Starts drawing and presenting frames on a dedicated thread.
+ */
+STATUS game_start_render_thread(GAME *game);
+
+/**
+ * @brief Stops the render thread; drawing goes back to the calling thread.
+ */
+STATUS game_stop_render_thread(GAME *game);
+
 /**
  * @brief Checks if the game has ended.
  */
@@ -0,0 +1,55 @@
+/**
+ * @file grid.h
+ * @brief Declaration of the uniform spatial grid used as collision broadphase.
+ *
+ * The grid divides the screen into square cells. Each entity is inserted,
+ * under an integer ID, into every cell its bounding box overlaps. A query
+ * returns the IDs found in the cells overlapped by a box, so an entity is
+ * only tested against its neighbours. The grid is cleared and rebuilt each
+ * tick, which is cheaper than updating it incrementally for the few dozen
+ * entities of the game.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef GRID_H
+#define GRID_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fixed.h"
+#include "types.h"
+
+/**
+ * @brief Structure representing a spatial grid.
+ */
+typedef struct _grid GRID;
+
+/**
+ * @brief Creates an empty grid covering width x height pixels.
+ */
+GRID *grid_create(int width, int height, int cell_size, int max_id, int max_nodes);
+
+/**
+ * @brief Destroys the grid.
+ */
+STATUS grid_destroy(GRID *grid);
+
+/**
+ * @brief Removes every entry from the grid.
+ */
+STATUS grid_clear(GRID *grid);
+
+/**
+ * @brief Inserts an ID into every cell overlapped by a box.
+ */
+STATUS grid_insert(GRID *grid, int id, FIXED x, FIXED y, int width, int height);
+
+/**
+ * @brief Collects, in ascending order, the IDs stored in the cells overlapped by a box.
+ */
+int grid_query(GRID *grid, FIXED x, FIXED y, int width, int height, int *ids, int max_ids);
+
+#endif /* GRID_H */
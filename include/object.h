@@ -6,6 +6,9 @@
 #include <string.h>
 #include <allegro5/allegro.h>
 #include <allegro5/allegro_primitives.h>
+#include "drawlist.h"
+#include "sprite.h"
+#include "fixed.h"
 #include "types.h"
 
 /**
@@ -16,7 +19,7 @@ typedef struct _object OBJECT;
 /**
  * @brief Creates a new object instance.
  */
-OBJECT *obj_create(ALLEGRO_BITMAP *bitmap, int source_x, int source_y, int width, int height, float x, float y, bool fixed);
+OBJECT *obj_create(SPRITE_ID sprite, FIXED x, FIXED y, bool fixed);
 
 /**
  * @brief Destroys an object and frees resources.
@@ -26,48 +29,33 @@ STATUS obj_destroy(OBJECT *object);
 /**
  * @brief Sets the x-coordinate of the object.
  */
-STATUS obj_set_x(OBJECT *object, float x);
+STATUS obj_set_x(OBJECT *object, FIXED x);
 
 /**
  * @brief Gets the x-coordinate of the object.
  */
-float obj_get_x(OBJECT *object);
+FIXED obj_get_x(OBJECT *object);
 
 /**
  * @brief Sets the y-coordinate of the object.
  */
-STATUS obj_set_y(OBJECT *object, float y);
+STATUS obj_set_y(OBJECT *object, FIXED y);
 
 /**
  * @brief Gets the y-coordinate of the object.
  */
-float obj_get_y(OBJECT *object);
+FIXED obj_get_y(OBJECT *object);
 
 /**
- * @brief Retrieves the bitmap of the object.
- */
-ALLEGRO_BITMAP *obj_get_bitmap(OBJECT *object);
-
-/**
- * @brief Sets the x-source coordinate for the object bitmap.
+ * @brief Sets the animation frame of the object.
  */
 STATUS obj_set_source_x(OBJECT *object, int source_x);
 
 /**
- * @brief Gets the x-source coordinate for the object bitmap.
+ * @brief Gets the animation frame of the object.
  */
 int obj_get_source_x(OBJECT *object);
 
-/**
- * @brief Sets the y-source coordinate for the object bitmap.
- */
-STATUS obj_set_source_y(OBJECT *object, int source_y);
-
-/**
- * @brief Gets the y-source coordinate for the object bitmap.
- */
-int obj_get_source_y(OBJECT *object);
-
 /**
  * @brief Sets the life value of the object.
  */
@@ -89,9 +77,9 @@ int obj_get_width(OBJECT *object);
 int obj_get_height(OBJECT *object);
 
 /**
- * @brief Prints the object to the screen.
+ * @brief Appends the object to a draw list.
  */
-STATUS obj_print(OBJECT *object);
+STATUS obj_queue_draw(OBJECT *object, DRAW_LIST *list, DRAW_LAYER layer);
 
 /**
  * @brief Sets the object's timer.
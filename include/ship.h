@@ -9,6 +9,8 @@
 
 #include "bullet.h"
 #include "config.h"
+#include "drawlist.h"
+#include "fixed.h"
 #include "types.h"
 
 #define MAX_SHIP_BULLETS 1
@@ -20,8 +22,8 @@ typedef struct _ship SHIP;
 /**
  * @brief Creates a new ship with the specified parameters.
  */
-SHIP *ship_create(ALLEGRO_BITMAP *bitmap, int width, int height, float x,
-                  float y, int dir, int life);
+SHIP *ship_create(ALLEGRO_BITMAP *bitmap, int width, int height, FIXED x,
+                  FIXED y, int dir, int life);
 
 /**
  * @brief Destroys the ship, freeing its resources.
@@ -31,22 +33,22 @@ STATUS ship_destroy(SHIP *ship);
 /**
  * @brief Sets the X position of the ship.
  */
-STATUS ship_set_x(SHIP *ship, float x);
+STATUS ship_set_x(SHIP *ship, FIXED x);
 
 /**
  * @brief Gets the X position of the ship.
  */
-float ship_get_x(SHIP *ship);
+FIXED ship_get_x(SHIP *ship);
 
 /**
  * @brief Sets the Y position of the ship.
  */
-STATUS ship_set_y(SHIP *ship, float y);
+STATUS ship_set_y(SHIP *ship, FIXED y);
 
 /**
  * @brief Gets the Y position of the ship.
  */
-float ship_get_y(SHIP *ship);
+FIXED ship_get_y(SHIP *ship);
 
 /**
  * @brief Sets the direction of the ship.
@@ -98,16 +100,6 @@ STATUS ship_set_source_y(SHIP *ship, int source_y);
  */
 int ship_get_source_y(SHIP *ship);
 
-/**
- * @brief Sets the number of bullets fired by the ship.
- */
-STATUS ship_set_num_shots(SHIP *ship, long num_shots);
-
-/**
- * @brief Gets the number of bullets currently in play.
- */
-long ship_get_num_shots(SHIP *ship);
-
 /**
  * @brief Sets the life points of the ship.
  */
@@ -129,9 +121,9 @@ int ship_get_width(SHIP *ship);
 int ship_get_height(SHIP *ship);
 
 /**
- * @brief Renders the ship on the display.
+ * @brief Appends the ship to a draw list.
  */
-STATUS ship_print(SHIP *ship);
+STATUS ship_queue_draw(SHIP *ship, DRAW_LIST *list, DRAW_LAYER layer);
 
 /**
  * @brief Decreases the life points of the ship by a specified amount.
@@ -139,43 +131,18 @@ STATUS ship_print(SHIP *ship);
 STATUS ship_decrease_life(SHIP *ship, int amount);
 
 /**
- * @brief Adds a bullet to the ship's bullet array.
- */
-STATUS ship_add_bullet(SHIP *ship, BULLET *bala);
-
-/**
- * @brief Removes and returns the oldest bullet in the ship's queue.
- */
-BULLET *ship_dequeue_bullet(SHIP *ship);
-
-/**
- * @brief Removes and returns the bullet at a specified index.
- */
-BULLET *ship_extract_bullet_at(SHIP *ship, int i);
-
-/**
- * @brief Gets the bullet at a specified index.
- */
-BULLET *ship_get_bullet_at(SHIP *ship, int i);
-
-/**
- * @brief Moves the ship's bullets based on speed.
- */
-STATUS ship_move_bullet(SHIP *ship, float speed);
-
-/**
- * @brief Fires a new bullet from the ship.
+ * @brief Fires a new bullet from the ship's cannon.
  */
-STATUS ship_shoot(SHIP *ship, ALLEGRO_BITMAP *bitmap);
+BULLET *ship_shoot(SHIP *ship);
 
 /**
  * @brief Moves the ship based on its direction and speed.
  */
-STATUS ship_move(SHIP *ship, float speed);
+STATUS ship_move(SHIP *ship, FIXED speed);
 
 /**
  * @brief Checks if the ship is located at the given coordinates.
  */
-bool ship_some_loc(SHIP *ship, int x, int y);
+bool ship_some_loc(SHIP *ship, FIXED x, FIXED y);
 
 #endif /* SHIP_H */
\ No newline at end of file
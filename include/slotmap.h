@@ -0,0 +1,97 @@
+/**
+ * @file slotmap.h
+ * @brief Declaration of the SlotMap container and its associated functions.
+ *
+ * A slot map stores pointers in a packed array for fast iteration and hands
+ * out generation-checked handles that stay valid while the item lives, no
+ * matter how the packed array is reordered. Insert, remove and lookup by
+ * handle take constant time. Once an item is removed, every handle that
+ * referred to it is rejected.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "types.h"
+
+#define SLOTMAP_MAX_CAPACITY 0xFFFF ///< Slots are indexed with 16 bits
+#define SLOT_HANDLE_NONE 0          ///< Never returned for a stored item
+
+/**
+ * @brief Stable reference to an item of a slot map (slot and generation).
+ */
+typedef uint32_t SLOT_HANDLE;
+
+/**
+ * @brief Structure representing a slot map.
+ */
+typedef struct _slotmap SLOTMAP;
+
+/**
+ * @brief Creates an empty slot map able to hold capacity items.
+ */
+SLOTMAP *slotmap_create(int capacity);
+
+/**
+ * @brief Destroys the slot map. The stored items are not freed.
+ */
+STATUS slotmap_destroy(SLOTMAP *map);
+
+/**
+ * @brief Stores an item and returns its handle, or SLOT_HANDLE_NONE.
+ */
+SLOT_HANDLE slotmap_insert(SLOTMAP *map, void *item);
+
+/**
+ * @brief Removes the item referred to by a handle and returns it.
+ */
+void *slotmap_remove(SLOTMAP *map, SLOT_HANDLE handle);
+
+/**
+ * @brief Gets the item referred to by a handle, or NULL if it is stale.
+ */
+void *slotmap_get(SLOTMAP *map, SLOT_HANDLE handle);
+
+/**
+ * @brief Gets the packed position of the item referred to by a handle, or -1.
+ */
+int slotmap_index_of(SLOTMAP *map, SLOT_HANDLE handle);
+
+/**
+ * @brief Gets the number of items in the packed array.
+ */
+int slotmap_size(SLOTMAP *map);
+
+/**
+ * @brief Gets the item at position i of the packed array.
+ */
+void *slotmap_get_at(SLOTMAP *map, int i);
+
+/**
+ * @brief Gets the handle of the item at position i of the packed array.
+ */
+SLOT_HANDLE slotmap_handle_at(SLOTMAP *map, int i);
+
+/**
+ * @brief Removes the item at position i of the packed array and returns it.
+ */
+void *slotmap_remove_at(SLOTMAP *map, int i);
+
+/**
+ * @brief Empties position i of the packed array, leaving a tombstone.
+ */
+void *slotmap_clear_at(SLOTMAP *map, int i);
+
+/**
+ * @brief Removes every tombstone, keeping the order of the other items.
+ */
+STATUS slotmap_compact(SLOTMAP *map);
+
+#endif /* SLOTMAP_H */
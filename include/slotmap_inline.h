@@ -0,0 +1,62 @@
+/**
+ * @file slotmap_inline.h
+ * @brief In-tree view of SLOTMAP: its structure and inline packed access.
+ *
+ * slotmap.h keeps SLOTMAP opaque for outside users. The game modules
+ * include this header so loops over the packed array read the size and
+ * the items without a function call. The argument checks are kept in
+ * debug builds only.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef SLOTMAP_INLINE_H
+#define SLOTMAP_INLINE_H
+
+#include "check.h"
+#include "container.h"
+#include "slotmap.h"
+
+#define SLOT_FREE 0xFFFF ///< Packed index of a slot that holds no item
+
+/**
+ * @brief Entry of the packed array: the item and the slot that owns it.
+ */
+typedef struct {
+  void *item;    ///< Stored item (NULL marks a tombstone)
+  uint16_t slot; ///< Slot owning this entry
+} SLOT_ENTRY;
+
+DEFINE_DENSE_LIST(SLOT_ENTRY_LIST, slot_entry_list, SLOT_ENTRY)
+DEFINE_RING_BUFFER(SLOT_QUEUE, slot_queue, uint16_t)
+
+/**
+ * @struct _slotmap
+ * @brief Packed item array plus the slot table that handles point into.
+ */
+struct _slotmap {
+  int capacity;            ///< Maximum number of items
+  SLOT_ENTRY_LIST entries; ///< Packed array of items
+  uint16_t *slot_index;    ///< Packed position of each slot (SLOT_FREE if unused)
+  uint16_t *generation;    ///< Current generation of each slot
+  SLOT_QUEUE free_slots;   ///< Unused slots, oldest first
+};
+
+/**
+ * @brief Number of entries in the packed array, tombstones included.
+ */
+static inline int slotmap_count(const SLOTMAP *map) {
+  CHECK_ARG(map, 0);
+  return map->entries.size;
+}
+
+/**
+ * @brief Item at position i of the packed array (NULL for a tombstone).
+ */
+static inline void *slotmap_at(const SLOTMAP *map, int i) {
+  CHECK_ARG(map && i >= 0 && i < map->entries.size, NULL);
+  return map->entries.items[i].item;
+}
+
+#endif /* SLOTMAP_INLINE_H */
@@ -0,0 +1,63 @@
+/**
+ * @file sprite.h
+ * @brief Declaration of the shared sprite descriptors.
+ *
+ * Entities of the same kind share one bitmap and one frame size, so these
+ * are kept once in a table of sprite descriptors. Each entity stores only
+ * a one-byte SPRITE_ID and its current frame, and draws itself through
+ * sprite_draw().
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <allegro5/allegro.h>
+#include <stdint.h>
+
+#include "fixed.h"
+#include "types.h"
+
+/**
+ * @brief Identifies a sprite descriptor.
+ */
+typedef enum {
+  SPRITE_SHIP_BULLET,    ///< Player bullet
+  SPRITE_MARTIAN_BULLET, ///< Martian bullet (two animation frames)
+  SPRITE_EXPLOSION,      ///< Martian and UFO explosion
+  SPRITE_UFO,            ///< Mystery ship
+  SPRITE_BUNKER,         ///< Bunker parts (one row per shape, one column per damage state)
+  SPRITE_SHIP,           ///< Player ship (explosion frames after the first column)
+  SPRITE_MARTIAN,        ///< Martians (one row per type, one column per animation frame)
+  SPRITE_BUNKER_IMAGE,   ///< Current image of the bunkers, one column per bunker
+  NUM_SPRITES
+} SPRITE_ID;
+
+/**
+ * @brief Registers the bitmap and frame size of a sprite.
+ */
+STATUS sprite_register(SPRITE_ID id, ALLEGRO_BITMAP *bitmap, int width, int height);
+
+/**
+ * @brief Gets the bitmap of a sprite.
+ */
+ALLEGRO_BITMAP *sprite_get_bitmap(SPRITE_ID id);
+
+/**
+ * @brief Gets the frame width of a sprite.
+ */
+int sprite_get_width(SPRITE_ID id);
+
+/**
+ * @brief Gets the frame height of a sprite.
+ */
+int sprite_get_height(SPRITE_ID id);
+
+/**
+ * @brief Draws frame (frame_x, frame_y) of a sprite at (x, y).
+ */
+STATUS sprite_draw(SPRITE_ID id, int frame_x, int frame_y, FIXED x, FIXED y);
+
+#endif /* SPRITE_H */
@@ -0,0 +1,44 @@
+/**
+ * @file sprite_inline.h
+ * @brief In-tree view of the sprite table with inline size lookups.
+ *
+ * Only modules of the game include this header; outside code goes through
+ * the functions of sprite.h.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef SPRITE_INLINE_H
+#define SPRITE_INLINE_H
+
+#include "check.h"
+#include "sprite.h"
+
+/**
+ * @brief Bitmap and frame size shared by every entity of a kind.
+ */
+typedef struct {
+  ALLEGRO_BITMAP *bitmap; ///< Sprite sheet (not owned)
+  int width, height;      ///< Size of one frame
+} SPRITE;
+
+extern SPRITE sprite_table[NUM_SPRITES]; ///< Descriptors, indexed by SPRITE_ID
+
+/**
+ * @brief Frame width of a sprite (unchecked in release builds).
+ */
+static inline int sprite_width(SPRITE_ID id) {
+  CHECK_ARG(id < NUM_SPRITES, 0);
+  return sprite_table[id].width;
+}
+
+/**
+ * @brief Frame height of a sprite (unchecked in release builds).
+ */
+static inline int sprite_height(SPRITE_ID id) {
+  CHECK_ARG(id < NUM_SPRITES, 0);
+  return sprite_table[id].height;
+}
+
+#endif /* SPRITE_INLINE_H */
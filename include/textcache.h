@@ -0,0 +1,56 @@
+/**
+ * @file textcache.h
+ * @brief Declaration of the cache of pre-rendered text lines.
+ *
+ * Drawing TTF text shapes and rasterises every glyph of the line each time.
+ * The cache keeps each line of the HUD and the overlays in its own small
+ * bitmap, indexed by a slot number chosen by the caller, and renders it
+ * again only when its text or colour changes. Drawing an unchanged line
+ * is then a single blit.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "types.h"
+
+#define TEXT_CACHE_MAX_TEXT 32 ///< Longest cached line, terminator included
+
+/**
+ * @brief Structure representing a text cache.
+ */
+typedef struct _textcache TEXT_CACHE;
+
+/**
+ * @brief Creates a cache of num_slots lines drawn with font.
+ */
+TEXT_CACHE *textcache_create(ALLEGRO_FONT *font, int num_slots);
+
+/**
+ * @brief Destroys the cache and the bitmaps of its lines.
+ */
+STATUS textcache_destroy(TEXT_CACHE *cache);
+
+/**
+ * @brief Draws a line of text through a slot of the cache.
+ */
+STATUS textcache_draw(TEXT_CACHE *cache, int slot, ALLEGRO_COLOR color, float x, float y,
+                      int flags, const char *text);
+
+/**
+ * @brief Draws a formatted number through a slot, formatting it only when it changes.
+ */
+STATUS textcache_draw_number(TEXT_CACHE *cache, int slot, ALLEGRO_COLOR color, float x, float y,
+                             int flags, const char *format, int value);
+
+#endif /* TEXTCACHE_H */
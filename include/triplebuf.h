@@ -0,0 +1,69 @@
+/**
+ * @file triplebuf.h
+ * @brief Declaration of the lock-free triple buffer.
+ *
+ * A triple buffer hands whole frames from one writer thread to one reader
+ * thread without either of them ever waiting for the other. The caller
+ * keeps three copies of its data, indexed 0 to 2. At any time the writer
+ * owns one of them (back), the reader owns another (front) and the third
+ * is the latest finished frame, waiting in between. Publishing swaps back
+ * with the one in between; acquiring swaps front with it if it is newer.
+ * Frames the reader did not get to in time are simply replaced.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#ifndef TRIPLEBUF_H
+#define TRIPLEBUF_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#include "types.h"
+
+#define TRIPLEBUF_SLOTS 3 ///< Copies of the data the caller keeps
+
+/**
+ * @brief Ownership of the three slots of a triple buffer.
+ *
+ * back is only touched by the writer and front only by the reader; the
+ * two threads meet on the single atomic word middle.
+ */
+typedef struct {
+  int back;          ///< Slot the writer fills
+  int front;         ///< Slot the reader uses
+  atomic_int middle; ///< Slot in between, plus a flag while it is not yet acquired
+} TRIPLE_BUFFER;
+
+/**
+ * @brief Initialises a triple buffer with no published frame.
+ */
+STATUS triplebuf_init(TRIPLE_BUFFER *buffer);
+
+/**
+ * @brief Slot the writer is filling.
+ */
+int triplebuf_back(const TRIPLE_BUFFER *buffer);
+
+/**
+ * @brief Publishes the back slot and gives the writer a new one (writer only).
+ */
+int triplebuf_publish(TRIPLE_BUFFER *buffer);
+
+/**
+ * @brief Whether a frame was published since the reader last acquired one.
+ */
+bool triplebuf_fresh(TRIPLE_BUFFER *buffer);
+
+/**
+ * @brief Takes the latest published frame, if newer than the front slot (reader only).
+ */
+bool triplebuf_acquire(TRIPLE_BUFFER *buffer);
+
+/**
+ * @brief Slot the reader is using.
+ */
+int triplebuf_front(const TRIPLE_BUFFER *buffer);
+
+#endif /* TRIPLEBUF_H */
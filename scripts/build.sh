@@ -92,11 +92,10 @@ else
     gcc -c src/game.c -I include $(pkg-config --cflags allegro-5) -Wall -g -o game.o
     gcc -c src/bullet.c -I include $(pkg-config --cflags allegro-5) -Wall -g -o bullet.o
     gcc -c src/ship.c -I include $(pkg-config --cflags allegro-5) -Wall -g -o ship.o
-    gcc -c src/martian.c -I include $(pkg-config --cflags allegro-5) -Wall -g -o martian.o
     gcc -c src/object.c -I include $(pkg-config --cflags allegro-5) -Wall -g -o object.o
 
     # Enlazar
-    gcc -o SpaceInvaders main.o game.o bullet.o ship.o martian.o object.o \
+    gcc -o SpaceInvaders main.o game.o bullet.o ship.o object.o \
         $(pkg-config --libs allegro-5 allegro_main-5 allegro_image-5 allegro_font-5 allegro_ttf-5 allegro_primitives-5)
 
     print_success "Compilación completada"
@@ -0,0 +1,161 @@
+/**
+ * @file atlas.c
+ * @brief Implementation of the texture atlas.
+ *
+ * Regions are packed in shelves: they are placed left to right along the
+ * current shelf, and a new shelf is opened under the tallest region of the
+ * previous one when a region does not fit. The game only packs a handful
+ * of small sprites once, so this simple scheme wastes little space.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#include "atlas.h"
+
+#define ATLAS_PADDING 1 ///< Transparent gap between regions, so filtering never bleeds
+
+/**
+ * @struct _atlas
+ * @brief Atlas bitmap plus the shelf packing state.
+ */
+struct _atlas {
+  ALLEGRO_BITMAP *bitmap; ///< Bitmap shared by every region
+  int width, height;      ///< Size of the atlas in pixels
+  int x;                  ///< Next free column on the current shelf
+  int y;                  ///< Top of the current shelf
+  int shelf_height;       ///< Height of the tallest region on the current shelf
+};
+
+/**
+ * @brief Creates an empty atlas.
+ *
+ * The atlas is created with the current new-bitmap flags, so it is a video
+ * bitmap when a display exists.
+ *
+ * @param width Width of the atlas in pixels.
+ * @param height Height of the atlas in pixels.
+ * @return Pointer to the created ATLAS or NULL on failure.
+ */
+ATLAS *atlas_create(int width, int height) {
+  ATLAS *new_atlas = NULL;
+  ALLEGRO_STATE state;
+
+  if (width <= 0 || height <= 0) {
+    return NULL;
+  }
+
+  new_atlas = (ATLAS *)malloc(sizeof(ATLAS));
+  if (!new_atlas) {
+    return NULL;
+  }
+
+  new_atlas->bitmap = al_create_bitmap(width, height);
+  if (!new_atlas->bitmap) {
+    free(new_atlas);
+    return NULL;
+  }
+
+  new_atlas->width = width;
+  new_atlas->height = height;
+  new_atlas->x = 0;
+  new_atlas->y = 0;
+  new_atlas->shelf_height = 0;
+
+  al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP);
+  al_set_target_bitmap(new_atlas->bitmap);
+  al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+  al_restore_state(&state);
+
+  return new_atlas;
+}
+
+/**
+ * @brief Destroys the atlas and frees its memory.
+ *
+ * @param atlas Pointer to the ATLAS to destroy.
+ * @return OK on success, ERROR if atlas is NULL.
+ */
+STATUS atlas_destroy(ATLAS *atlas) {
+  if (!atlas) {
+    return ERROR;
+  }
+
+  al_destroy_bitmap(atlas->bitmap);
+  free(atlas);
+
+  return OK;
+}
+
+/**
+ * @brief Reserves a transparent region of the atlas.
+ *
+ * @param atlas Pointer to the ATLAS.
+ * @param width Width of the region in pixels.
+ * @param height Height of the region in pixels.
+ * @return Sub-bitmap covering the region, or NULL if it does not fit.
+ *         The caller destroys it before the atlas.
+ */
+ALLEGRO_BITMAP *atlas_reserve(ATLAS *atlas, int width, int height) {
+  ALLEGRO_BITMAP *region = NULL;
+
+  if (!atlas || width <= 0 || height <= 0 || width > atlas->width) {
+    return NULL;
+  }
+
+  // Open a new shelf under the current one
+  if (atlas->x + width > atlas->width) {
+    atlas->x = 0;
+    atlas->y += atlas->shelf_height + ATLAS_PADDING;
+    atlas->shelf_height = 0;
+  }
+
+  if (atlas->y + height > atlas->height) {
+    return NULL;
+  }
+
+  region = al_create_sub_bitmap(atlas->bitmap, atlas->x, atlas->y, width, height);
+  if (!region) {
+    return NULL;
+  }
+
+  atlas->x += width + ATLAS_PADDING;
+  if (height > atlas->shelf_height) {
+    atlas->shelf_height = height;
+  }
+
+  return region;
+}
+
+/**
+ * @brief Copies a bitmap into the atlas.
+ *
+ * The pixels are copied unblended, so transparent pixels stay transparent.
+ * The source bitmap is left untouched and may be destroyed afterwards.
+ *
+ * @param atlas Pointer to the ATLAS.
+ * @param bitmap Bitmap to copy.
+ * @return Sub-bitmap holding the copy, or NULL if it does not fit.
+ *         The caller destroys it before the atlas.
+ */
+ALLEGRO_BITMAP *atlas_add(ATLAS *atlas, ALLEGRO_BITMAP *bitmap) {
+  ALLEGRO_BITMAP *region = NULL;
+  ALLEGRO_STATE state;
+
+  if (!atlas || !bitmap) {
+    return NULL;
+  }
+
+  region = atlas_reserve(atlas, al_get_bitmap_width(bitmap), al_get_bitmap_height(bitmap));
+  if (!region) {
+    return NULL;
+  }
+
+  al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP | ALLEGRO_STATE_BLENDER);
+  al_set_target_bitmap(region);
+  al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+  al_draw_bitmap(bitmap, 0, 0, 0);
+  al_restore_state(&state);
+
+  return region;
+}
@@ -6,37 +6,29 @@
  * Bullets are created with specific properties, including direction and speed, and can be 
  * checked for collisions with other objects in the game.
  * 
- * Each Bullet contains information on its position, size, direction, and associated bitmap.
+ * Each Bullet contains its position, direction and owner, plus the ID and frame of its
+ * sprite. The bitmap and size are shared by all bullets of a kind (see sprite.h).
  * 
  * Author: RGiskard7
  * Date: 13/11/2024
  */
 
-#include "bullet.h"
-
-struct _bullet {
-    float x, y;                       ///< Bullet's x and y coordinates
-    int dir;                          ///< Bullet direction (UP or DOWN)
-    ALLEGRO_BITMAP *bitmap;           ///< Bitmap representing the bullet image
-    int source_x, source_y;           ///< Source coordinates in the bitmap
-    int width, height;                ///< Dimensions of the bullet
-};
+#include "bullet_inline.h"
 
 /**
  * @brief Creates a bullet with specified properties.
  * 
- * @param bitmap Bitmap image for the bullet.
- * @param width Width of the bullet.
- * @param height Height of the bullet.
+ * @param sprite Sprite descriptor of the bullet.
  * @param x Initial x-coordinate.
  * @param y Initial y-coordinate.
  * @param dir Initial direction.
+ * @param owner Who fired the bullet.
  * @return Pointer to the created bullet or NULL if allocation fails.
  */
-BULLET *bullet_create(ALLEGRO_BITMAP *bitmap, int width, int height, float x, float y, int dir) {
+BULLET *bullet_create(SPRITE_ID sprite, FIXED x, FIXED y, int dir, BULLET_OWNER owner) {
     BULLET *new_bullet = NULL;
 
-    if (!bitmap) {
+    if (sprite >= NUM_SPRITES) {
         return NULL;
     }
 
@@ -45,18 +37,16 @@ BULLET *bullet_create(ALLEGRO_BITMAP *bitmap, int width, int height, float x, fl
         return NULL;
     }
 
-    new_bullet->bitmap = bitmap;
+    new_bullet->sprite = sprite;
 
     new_bullet->x = x; //coordenadas de la bullet
     new_bullet->y = y;
+    new_bullet->prev_y = y;
 
     new_bullet->dir = dir;
+    new_bullet->owner = owner;
 
     new_bullet->source_x = 0;
-    new_bullet->source_y = 0;
-
-    new_bullet->width = width;
-    new_bullet->height = height;
 
     return new_bullet;
 }
@@ -85,7 +75,7 @@ STATUS bullet_destroy(BULLET *bullet) {
  * @param cx New x-coordinate.
  * @return STATUS code (OK on success, ERROR if bullet is NULL).
  */
-STATUS bullet_set_x(BULLET *bullet, float cx) {
+STATUS bullet_set_x(BULLET *bullet, FIXED cx) {
     if (!bullet) {
         return ERROR;
     }
@@ -101,9 +91,9 @@ STATUS bullet_set_x(BULLET *bullet, float cx) {
  * @param bullet Pointer to the bullet.
  * @return X-coordinate, or ERROR if bullet is NULL.
  */
-float bullet_get_x(BULLET *bullet) {
+FIXED bullet_get_x(BULLET *bullet) {
     if (!bullet) {
-        return 0.0f;
+        return 0;
     }
 
     return bullet->x;
@@ -116,12 +106,13 @@ float bullet_get_x(BULLET *bullet) {
  * @param cy New y-coordinate.
  * @return STATUS code (OK on success, ERROR if bullet is NULL).
  */
-STATUS bullet_set_y(BULLET *bullet, float cy) {
+STATUS bullet_set_y(BULLET *bullet, FIXED cy) {
     if (!bullet) {
         return ERROR;
     }
 
     bullet->y = cy;
+    bullet->prev_y = cy; // A jump is not a move: no sweep
 
     return OK;
 }
@@ -132,9 +123,9 @@ STATUS bullet_set_y(BULLET *bullet, float cy) {
  * @param bullet Pointer to the bullet.
  * @return Y-coordinate, or ERROR if bullet is NULL.
  */
-float bullet_get_y(BULLET *bullet) {
+FIXED bullet_get_y(BULLET *bullet) {
     if (!bullet) {
-        return 0.0f;
+        return 0;
     }
 
     return bullet->y;
@@ -148,7 +139,7 @@ float bullet_get_y(BULLET *bullet) {
  * @return STATUS code (OK on success, ERROR if bullet is NULL or dir is invalid).
  */
 STATUS bullet_set_dir(BULLET *bullet, int dir) {
-    if (!bullet || dir < 0) {
+    if (!bullet || dir < 0 || dir > UINT8_MAX) {
         return ERROR;
     }
 
@@ -171,45 +162,27 @@ int bullet_get_dir(BULLET *bullet) {
 }
 
 /**
- * @brief Sets the bitmap for the bullet.
- * 
- * @param bullet Pointer to the bullet.
- * @param image Bitmap image to set.
- * @return STATUS code (OK on success, ERROR if bullet or image is NULL).
- */
-STATUS bullet_set_bitmap(BULLET *bullet, ALLEGRO_BITMAP *image) {
-    if (!bullet || !image) {
-        return ERROR;
-    }
-
-    bullet->bitmap = image;
-
-    return OK;
-}
-
-/**
- * @brief Retrieves the bitmap of the bullet.
- * 
+ * @brief Retrieves who fired the bullet.
+ *
  * @param bullet Pointer to the bullet.
- * @return Pointer to the bitmap, or NULL if bullet is NULL.
+ * @return Owner of the bullet, or BULLET_MARTIAN if bullet is NULL.
  */
-ALLEGRO_BITMAP *bullet_get_bitmap(BULLET *bullet) {
+BULLET_OWNER bullet_get_owner(BULLET *bullet) {
     if (!bullet) {
-        return NULL;
+        return BULLET_MARTIAN;
     }
-
-    return bullet->bitmap;
+    return bullet->owner;
 }
 
 /**
- * @brief Sets the x-coordinate in the bitmap's source region.
+ * @brief Sets the animation frame of the bullet.
  * 
  * @param bullet Pointer to the bullet.
- * @param source_x Source x-coordinate.
- * @return STATUS code (OK on success, ERROR if bullet is NULL).
+ * @param source_x Frame (column in the sprite sheet).
+ * @return STATUS code (OK on success, ERROR if bullet is NULL or the frame is invalid).
  */
 STATUS bullet_set_source_x(BULLET *bullet, int source_x) {
-    if (!bullet) {
+    if (!bullet || source_x < 0 || source_x > UINT8_MAX) {
         return ERROR;
     }
 
@@ -219,10 +192,10 @@ STATUS bullet_set_source_x(BULLET *bullet, int source_x) {
 }
 
 /**
- * @brief Retrieves the x-coordinate of the source region.
+ * @brief Retrieves the animation frame of the bullet.
  * 
  * @param bullet Pointer to the bullet.
- * @return Source x-coordinate, or ERROR if bullet is NULL.
+ * @return Frame (column in the sprite sheet), or ERROR if bullet is NULL.
  */
 int bullet_get_source_x(BULLET *bullet) {
     if (!bullet) {
@@ -232,37 +205,6 @@ int bullet_get_source_x(BULLET *bullet) {
     return bullet->source_x;
 }
 
-/**
- * @brief Sets the y-coordinate in the bitmap's source region.
- * 
- * @param bullet Pointer to the bullet.
- * @param source_y Source y-coordinate.
- * @return STATUS code (OK on success, ERROR if bullet is NULL).
- */
-STATUS bullet_set_source_y(BULLET *bullet, int source_y) {
-    if (!bullet) {
-        return ERROR;
-    }
-
-    bullet->source_y = source_y;
-
-    return OK;
-}
-
-/**
- * @brief Retrieves the y-coordinate of the source region.
- * 
- * @param bullet Pointer to the bullet.
- * @return Source y-coordinate, or ERROR if bullet is NULL.
- */
-int bullet_get_source_y(BULLET *bullet) {
-    if (!bullet) {
-        return ERROR;
-    }
-
-    return bullet->source_y;
-}
-
 /**
  * @brief Retrieves the width of the bullet.
  * 
@@ -274,7 +216,7 @@ int bullet_get_width(BULLET *bullet) {
         return 0;
     }
 
-    return bullet->width;
+    return sprite_get_width(bullet->sprite);
 }
 
 /**
@@ -288,21 +230,26 @@ int bullet_get_height(BULLET *bullet) {
         return 0;
     }
 
-    return bullet->height;
+    return sprite_get_height(bullet->sprite);
 }
 
 /**
  * @brief Moves the bullet based on its direction and speed.
  * 
+ * The position before the move is kept, so collisions can be tested
+ * against the whole segment travelled (see bullet_sweep_overlaps()).
+ * 
  * @param bullet Pointer to the bullet.
  * @param speed Speed to move the bullet.
  * @return STATUS code (OK on success, ERROR if bullet is NULL).
  */
-STATUS bullet_move(BULLET *bullet, float speed) {
+STATUS bullet_move(BULLET *bullet, FIXED speed) {
     if (!bullet) {
         return ERROR;
     }
 
+    bullet->prev_y = bullet->y;
+
     if (bullet->dir == UP) {
         bullet->y -= speed;
     } else if (bullet->dir == DOWN) {
@@ -313,40 +260,17 @@ STATUS bullet_move(BULLET *bullet, float speed) {
 }
 
 /**
- * @brief Draws the bullet on the screen.
- * 
+ * @brief Appends the bullet to a draw list.
+ *
  * @param bullet Pointer to the bullet.
- * @return STATUS code (OK on success, ERROR if bullet is NULL).
+ * @param list Draw list of the frame.
+ * @param layer Layer the bullet is drawn in.
+ * @return STATUS code (OK on success, ERROR if bullet is NULL or the list is full).
  */
-STATUS bullet_print(BULLET *bullet) {
+STATUS bullet_queue_draw(BULLET *bullet, DRAW_LIST *list, DRAW_LAYER layer) {
     if (!bullet) {
         return ERROR;
     }
 
-    al_draw_bitmap_region(bullet->bitmap, (bullet->source_x * bullet->width), (bullet->source_y * bullet->height), 
-        bullet->width, bullet->height, bullet->x, bullet->y, 0);
-
-    return OK;
+    return drawlist_push(list, layer, bullet->sprite, bullet->source_x, 0, bullet->x, bullet->y);
 }
-
-/**
- * @brief Checks if the bullet collides with a given object.
- * 
- * @param bullet Pointer to the bullet.
- * @param obj_x X-coordinate of the object.
- * @param obj_y Y-coordinate of the object.
- * @param obj_width Width of the object.
- * @param obj_height Height of the object.
- * @return true if collision is detected, false otherwise.
- */
-bool bullet_check_collision(BULLET *bullet, int obj_x, int obj_y, int obj_width, int obj_height) {
-    if ((bullet->x < obj_x + obj_width) && 
-        (bullet->x + bullet->width > obj_x) && 
-        (bullet->y < obj_y + obj_height) && 
-        (bullet->y + bullet->height > obj_y)) {
-
-        return true;
-    } 
-
-    return false;
-}
\ No newline at end of file
@@ -2,50 +2,169 @@
  * @file bunker.c
  * @brief Implementation of the Bunker structure and associated functions.
  *
- * This file provides functions to create, manage, and render bunker parts
- * within the Space Invaders game. Each bunker part is a section of a larger
- * shield, rendered from a sprite sheet and capable of absorbing a fixed
- * number of hits before being destroyed.
+ * This file provides functions to create, damage, and render the bunkers
+ * of the Space Invaders game. The shape of a bunker is read once from the
+ * undamaged frames of the bunker sprite sheet into a bit mask. Every hit
+ * clears the pixels under a small explosion stamp, so bunkers wear away
+ * where they are actually shot.
  *
  * Author: RGiskard7
  * Date: 13/11/2024
  */
 
-#include "bunker.h"
+#include "bunker_inline.h"
+
+#define BUNKER_STAMP_SIZE 8 ///< Side of the impact stamp in pixels
+
+_Static_assert(BUNKER_WIDTH <= 64, "a bunker row must fit in one 64-bit word");
+
+/**
+ * @brief Pixels removed by one impact, bit x standing for column x.
+ *
+ * A ragged splat rather than a square, so repeated hits leave the
+ * irregular holes of the arcade game.
+ */
+static const uint8_t bunker_stamp[BUNKER_STAMP_SIZE] = {
+    0x24, 0x7A, 0x3E, 0xFF, 0x7F, 0x3C, 0x5E, 0x91,
+};
 
 /**
- * @struct _bunker
- * @brief Represents a single destructible part of a bunker shield.
+ * @brief Layout of the sprite parts that make up a bunker.
  *
- * Stores position, sprite sheet coordinates, dimensions, and remaining
- * life for one section of a bunker. The source_x coordinate advances
- * with each hit to show progressive damage on the sprite.
+ * Each part is placed at (col, row) in part units and copies the given
+ * shape (row of the sprite sheet). The sheet column 0 is the undamaged frame.
  */
-struct _bunker {
-    float x, y;              ///< Screen coordinates of the bunker part
-    ALLEGRO_BITMAP *bitmap;  ///< Shared sprite sheet for all bunker parts
-    int source_x, source_y;  ///< Source coordinates within the sprite sheet
-    int width, height;       ///< Dimensions of the bunker part
-    int life;                ///< Remaining hits before destruction
+static const struct {
+    int col, row, shape;
+} bunker_parts[] = {
+    {0, 0, 0}, // Top left
+    {1, 0, 4}, // Top middle (full block)
+    {2, 0, 2}, // Top right
+    {0, 1, 1}, // Bottom left
+    {2, 1, 3}, // Bottom right
 };
 
 /**
- * @brief Creates a new bunker part with the specified attributes.
+ * @brief Undamaged shape, as last read from a sprite sheet.
  *
- * @param bitmap Shared sprite sheet bitmap for all bunker parts.
- * @param source_x Initial x-coordinate in the sprite sheet (damage frame).
- * @param source_y Y-coordinate in the sprite sheet (part shape/type).
- * @param width Width of the bunker part.
- * @param height Height of the bunker part.
+ * Bunkers are rebuilt on every new game, when the render thread may be
+ * drawing with the sheet. Only the first bunker reads (and locks) the
+ * sheet; the others copy the shape from here.
+ */
+static struct {
+    ALLEGRO_BITMAP *bitmap;         ///< Sheet the shape was read from, or NULL
+    uint64_t rows[BUNKER_HEIGHT];   ///< Occupancy mask of an undamaged bunker
+    uint32_t pixel;                 ///< Colour of a solid pixel
+} bunker_shape;
+
+/**
+ * @brief Converts a box to the range of bunker rows or columns it covers.
+ *
+ * @param offset Start of the box relative to the bunker.
+ * @param size Size of the box in pixels.
+ * @param limit Number of rows or columns of the bunker.
+ * @param first Output first index, clamped to the bunker.
+ * @param last Output last index, clamped to the bunker.
+ * @return true if the range is not empty.
+ */
+static bool bunker_span(FIXED offset, int size, int limit, int *first, int *last) {
+    *first = FIXED_TO_INT(offset);
+    *last = FIXED_TO_INT(offset + INT_TO_FIXED(size) - 1);
+
+    if (*first < 0) *first = 0;
+    if (*last >= limit) *last = limit - 1;
+
+    return size > 0 && *first <= *last;
+}
+
+/**
+ * @brief Mask of the bunker columns covered by a box.
+ *
+ * @param bunker Pointer to the BUNKER.
+ * @param x X-coordinate of the box.
+ * @param width Width of the box in pixels.
+ * @return One bit per covered column, 0 if the box misses the bunker.
+ */
+static uint64_t bunker_columns(const BUNKER *bunker, FIXED x, int width) {
+    int c0, c1;
+
+    if (!bunker_span(x - bunker->x, width, BUNKER_WIDTH, &c0, &c1)) {
+        return 0;
+    }
+
+    return (UINT64_MAX >> (63 - (c1 - c0))) << c0;
+}
+
+/**
+ * @brief Reads the bunker shape from the undamaged sprite frames.
+ *
+ * Any pixel that is not fully transparent is solid. The colour of the
+ * first solid pixel is used to draw the whole bunker. The sheet is only
+ * read the first time; later calls with the same sheet copy the shape.
+ *
+ * @param bunker Pointer to the BUNKER.
+ * @param bitmap Bunker sprite sheet.
+ */
+static void bunker_load_mask(BUNKER *bunker, ALLEGRO_BITMAP *bitmap) {
+    if (bunker_shape.bitmap == bitmap) {
+        memcpy(bunker->rows, bunker_shape.rows, sizeof(bunker->rows));
+        bunker->pixel = bunker_shape.pixel;
+        return;
+    }
+
+    // Reading pixel by pixel is only fast on a locked bitmap
+    bool locked = al_lock_bitmap(bitmap, ALLEGRO_PIXEL_FORMAT_ANY, ALLEGRO_LOCK_READONLY) != NULL;
+
+    memset(bunker->rows, 0, sizeof(bunker->rows));
+    bunker->pixel = 0;
+
+    for (size_t i = 0; i < sizeof(bunker_parts) / sizeof(bunker_parts[0]); i++) {
+        int left = bunker_parts[i].col * BUNKER_PART_WIDTH;
+        int top = bunker_parts[i].row * BUNKER_PART_HEIGHT;
+
+        for (int py = 0; py < BUNKER_PART_HEIGHT; py++) {
+            for (int px = 0; px < BUNKER_PART_WIDTH; px++) {
+                unsigned char r, g, b, a;
+
+                al_unmap_rgba(al_get_pixel(bitmap, px, bunker_parts[i].shape * BUNKER_PART_HEIGHT + py),
+                              &r, &g, &b, &a);
+                if (a == 0) {
+                    continue;
+                }
+
+                bunker->rows[top + py] |= (uint64_t)1 << (left + px);
+                if (bunker->pixel == 0) {
+                    bunker->pixel = (uint32_t)a << 24 | (uint32_t)b << 16 | (uint32_t)g << 8 | r;
+                }
+            }
+        }
+    }
+
+    if (locked) {
+        al_unlock_bitmap(bitmap);
+    }
+
+    bunker_shape.bitmap = bitmap;
+    memcpy(bunker_shape.rows, bunker->rows, sizeof(bunker->rows));
+    bunker_shape.pixel = bunker->pixel;
+}
+
+/**
+ * @brief Creates a new bunker with the specified attributes.
+ *
+ * @param sprite Sprite descriptor whose undamaged frames give the bunker shape.
+ * @param image Sprite with BUNKER_WIDTH x BUNKER_HEIGHT frames holding the
+ *              bunker images. Its bitmap is only needed for rendering.
+ * @param frame Column of image this bunker is drawn from.
  * @param x X-coordinate on screen.
  * @param y Y-coordinate on screen.
  * @return Pointer to the created BUNKER or NULL on failure.
  */
-BUNKER *bunker_create(ALLEGRO_BITMAP *bitmap, int source_x, int source_y,
-                      int width, int height, float x, float y) {
+BUNKER *bunker_create(SPRITE_ID sprite, SPRITE_ID image, int frame, FIXED x, FIXED y) {
     BUNKER *new_bunker = NULL;
+    ALLEGRO_BITMAP *bitmap = sprite_get_bitmap(sprite);
 
-    if (!bitmap) {
+    if (!bitmap || image >= NUM_SPRITES || frame < 0) {
         return NULL;
     }
 
@@ -54,24 +173,18 @@ BUNKER *bunker_create(ALLEGRO_BITMAP *bitmap, int source_x, int source_y,
         return NULL;
     }
 
-    new_bunker->bitmap = bitmap;
-
+    new_bunker->image = (uint8_t)image;
+    new_bunker->frame = (uint8_t)frame;
     new_bunker->x = x;
     new_bunker->y = y;
 
-    new_bunker->source_x = source_x;
-    new_bunker->source_y = source_y;
-
-    new_bunker->width = width;
-    new_bunker->height = height;
-
-    new_bunker->life = BUNKER_LIFE;
+    bunker_load_mask(new_bunker, bitmap);
 
     return new_bunker;
 }
 
 /**
- * @brief Destroys a bunker part and frees its allocated memory.
+ * @brief Destroys a bunker and frees its allocated memory.
  *
  * @param bunker Pointer to the BUNKER to destroy.
  * @return OK on success, ERROR if bunker is NULL.
@@ -87,149 +200,188 @@ STATUS bunker_destroy(BUNKER *bunker) {
 }
 
 /**
- * @brief Gets the x-coordinate of the bunker part.
+ * @brief Gets the x-coordinate of the bunker.
  *
  * @param bunker Pointer to the BUNKER.
  * @return X-coordinate, or -1.0 if bunker is NULL.
  */
-float bunker_get_x(BUNKER *bunker) {
+FIXED bunker_get_x(BUNKER *bunker) {
     if (!bunker) {
-        return -1.0;
+        return INT_TO_FIXED(-1);
     }
 
     return bunker->x;
 }
 
 /**
- * @brief Gets the y-coordinate of the bunker part.
+ * @brief Gets the y-coordinate of the bunker.
  *
  * @param bunker Pointer to the BUNKER.
  * @return Y-coordinate, or -1.0 if bunker is NULL.
  */
-float bunker_get_y(BUNKER *bunker) {
+FIXED bunker_get_y(BUNKER *bunker) {
     if (!bunker) {
-        return -1.0;
+        return INT_TO_FIXED(-1);
     }
 
     return bunker->y;
 }
 
 /**
- * @brief Gets the x-source coordinate in the sprite sheet.
+ * @brief Finds the first bunker row with solid pixels under a box.
  *
- * The source_x advances with each hit to display progressive damage.
+ * The box is usually the area swept by a bullet. Rows are scanned in the
+ * direction the bullet travels, so the row returned is the first one it
+ * met: bottom-up for bullets moving up, top-down otherwise.
  *
  * @param bunker Pointer to the BUNKER.
- * @return Source x-coordinate, or -1 if bunker is NULL.
+ * @param x X-coordinate of the box.
+ * @param y Y-coordinate of the box.
+ * @param width Width of the box in pixels.
+ * @param height Height of the box in pixels.
+ * @param upward Whether the bullet moves up the screen.
+ * @return Row index relative to the bunker top, or -1 if no solid pixel lies under the box.
  */
-int bunker_get_source_x(BUNKER *bunker) {
-    if (!bunker) {
+int bunker_hit_row(BUNKER *bunker, FIXED x, FIXED y, int width, int height, bool upward) {
+    uint64_t columns;
+    int r0, r1;
+
+    if (!bunker || !bunker_span(y - bunker->y, height, BUNKER_HEIGHT, &r0, &r1)) {
         return -1;
     }
 
-    return bunker->source_x;
+    columns = bunker_columns(bunker, x, width);
+    if (!columns) {
+        return -1;
+    }
+
+    if (upward) {
+        for (int r = r1; r >= r0; r--) {
+            if (bunker->rows[r] & columns) return r;
+        }
+    } else {
+        for (int r = r0; r <= r1; r++) {
+            if (bunker->rows[r] & columns) return r;
+        }
+    }
+
+    return -1;
 }
 
 /**
- * @brief Sets the x-source coordinate in the sprite sheet.
+ * @brief Erodes the bunker with the impact stamp centred on (x, y).
  *
- * Used to advance the damage frame after each hit.
+ * Each stamp row is shifted to the impact column and cleared from the
+ * matching mask row with one AND-NOT.
  *
  * @param bunker Pointer to the BUNKER.
- * @param source_x New x-source coordinate value.
+ * @param x X-coordinate of the impact.
+ * @param y Y-coordinate of the impact.
  * @return OK on success, ERROR if bunker is NULL.
  */
-STATUS bunker_set_source_x(BUNKER *bunker, int source_x) {
+STATUS bunker_erode(BUNKER *bunker, FIXED x, FIXED y) {
+    int left, top;
+
     if (!bunker) {
         return ERROR;
     }
 
-    bunker->source_x = source_x;
-
-    return OK;
-}
+    left = FIXED_TO_INT(x - bunker->x) - BUNKER_STAMP_SIZE / 2;
+    top = FIXED_TO_INT(y - bunker->y) - BUNKER_STAMP_SIZE / 2;
 
-/**
- * @brief Gets the y-source coordinate in the sprite sheet.
- *
- * The source_y determines the shape/type of this bunker part and
- * remains constant throughout the part's lifetime.
- *
- * @param bunker Pointer to the BUNKER.
- * @return Source y-coordinate, or -1 if bunker is NULL.
- */
-int bunker_get_source_y(BUNKER *bunker) {
-    if (!bunker) {
-        return -1;
+    if (left <= -BUNKER_STAMP_SIZE || left >= BUNKER_WIDTH) {
+        return OK;
     }
 
-    return bunker->source_y;
-}
+    for (int i = 0; i < BUNKER_STAMP_SIZE; i++) {
+        int r = top + i;
+        uint64_t bits = bunker_stamp[i];
 
-/**
- * @brief Gets the remaining life of the bunker part.
- *
- * @param bunker Pointer to the BUNKER.
- * @return Remaining life, or 0 if bunker is NULL.
- */
-int bunker_get_life(BUNKER *bunker) {
-    if (!bunker) {
-        return 0;
+        if (r < 0 || r >= BUNKER_HEIGHT) {
+            continue;
+        }
+
+        bits = left >= 0 ? bits << left : bits >> -left;
+        bunker->rows[r] &= ~bits;
     }
 
-    return bunker->life;
+    return OK;
 }
 
 /**
- * @brief Sets the remaining life of the bunker part.
+ * @brief Clears every bunker pixel under a box.
+ *
+ * Used when martians walk through a bunker.
  *
  * @param bunker Pointer to the BUNKER.
- * @param life New life value.
+ * @param x X-coordinate of the box.
+ * @param y Y-coordinate of the box.
+ * @param width Width of the box in pixels.
+ * @param height Height of the box in pixels.
  * @return OK on success, ERROR if bunker is NULL.
  */
-STATUS bunker_set_life(BUNKER *bunker, int life) {
+STATUS bunker_erase(BUNKER *bunker, FIXED x, FIXED y, int width, int height) {
+    uint64_t columns;
+    int r0, r1;
+
     if (!bunker) {
         return ERROR;
     }
 
-    bunker->life = life;
+    columns = bunker_columns(bunker, x, width);
+    if (!columns || !bunker_span(y - bunker->y, height, BUNKER_HEIGHT, &r0, &r1)) {
+        return OK;
+    }
+
+    for (int r = r0; r <= r1; r++) {
+        bunker->rows[r] &= ~columns;
+    }
 
     return OK;
 }
 
 /**
- * @brief Gets the width of the bunker part.
+ * @brief Rewrites the bunker image from the mask.
+ *
+ * The image has to be locked, so the renderer only does this while it
+ * composites the cached scene, for bunker copies whose mask changed.
  *
  * @param bunker Pointer to the BUNKER.
- * @return Width, or 0 if bunker is NULL.
+ * @return OK on success, ERROR if bunker is NULL or the image cannot be locked.
  */
-int bunker_get_width(BUNKER *bunker) {
+STATUS bunker_write_image(BUNKER *bunker) {
+    ALLEGRO_LOCKED_REGION *region = NULL;
+    ALLEGRO_BITMAP *bitmap = NULL;
+
     if (!bunker) {
-        return 0;
+        return ERROR;
     }
 
-    return bunker->width;
-}
+    bitmap = sprite_get_bitmap(bunker->image);
+    region = al_lock_bitmap_region(bitmap, bunker->frame * BUNKER_WIDTH, 0, BUNKER_WIDTH, BUNKER_HEIGHT,
+                                   ALLEGRO_PIXEL_FORMAT_ABGR_8888, ALLEGRO_LOCK_WRITEONLY);
+    if (!region) {
+        return ERROR;
+    }
 
-/**
- * @brief Gets the height of the bunker part.
- *
- * @param bunker Pointer to the BUNKER.
- * @return Height, or 0 if bunker is NULL.
- */
-int bunker_get_height(BUNKER *bunker) {
-    if (!bunker) {
-        return 0;
+    for (int r = 0; r < BUNKER_HEIGHT; r++) {
+        uint32_t *dst = (uint32_t *)((char *)region->data + r * region->pitch);
+        uint64_t row = bunker->rows[r];
+
+        for (int c = 0; c < BUNKER_WIDTH; c++) {
+            dst[c] = (row >> c) & 1 ? bunker->pixel : 0;
+        }
     }
+    al_unlock_bitmap(bitmap);
 
-    return bunker->height;
+    return OK;
 }
 
 /**
- * @brief Renders the bunker part on the screen.
+ * @brief Renders the bunker on the screen.
  *
- * Draws the appropriate sprite region based on the current damage state
- * (source_x) and part shape (source_y).
+ * Drawing the bunker is a single blit of its image, as it was last
+ * written by bunker_write_image().
  *
  * @param bunker Pointer to the BUNKER.
  * @return OK on success, ERROR if bunker is NULL.
@@ -239,11 +391,5 @@ STATUS bunker_print(BUNKER *bunker) {
         return ERROR;
     }
 
-    al_draw_bitmap_region(bunker->bitmap,
-                          (bunker->source_x * bunker->width),
-                          (bunker->source_y * bunker->height),
-                          bunker->width, bunker->height,
-                          bunker->x, bunker->y, 0);
-
-    return OK;
+    return sprite_draw(bunker->image, bunker->frame, 0, bunker->x, bunker->y);
 }
@@ -0,0 +1,282 @@
+/**
+ * @file dirtymap.c
+ * @brief Implementation of the map of screen areas to redraw.
+ *
+ * Each row of tiles is a 64-bit word, bit c standing for tile column c,
+ * as the bunkers keep their pixels. Marking a box sets a run of bits in
+ * the rows it spans. The rectangles are built greedily: the first run of
+ * dirty tiles in a row is grown down over the rows where the same run is
+ * dirty, then removed, until no tile is left.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#include "dirtymap.h"
+
+/**
+ * @struct _dirtymap
+ * @brief Tile masks plus the rectangles built from them.
+ */
+struct _dirtymap {
+  int width, height;  ///< Covered area in pixels
+  int tile_size;      ///< Side of a tile in pixels
+  int cols, rows;     ///< Number of tiles in each direction
+  uint64_t *mask;     ///< One word per row of tiles
+  uint64_t *work;     ///< Tiles not yet covered while building the rectangles
+  DIRTY_RECT *rects;  ///< Output of dirtymap_rects(), one slot per tile at most
+};
+
+/**
+ * @brief Word with bits [c0, c1] set.
+ */
+static inline uint64_t dirtymap_run(int c0, int c1) {
+  uint64_t high = c1 >= 63 ? ~(uint64_t)0 : ((uint64_t)1 << (c1 + 1)) - 1;
+
+  return high & ~(((uint64_t)1 << c0) - 1);
+}
+
+/**
+ * @brief Index of the lowest set bit of a non-zero row.
+ */
+static inline int dirtymap_first_bit(uint64_t row) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(row);
+#else
+  int c = 0;
+  while (!(row & 1)) {
+    row >>= 1;
+    c++;
+  }
+  return c;
+#endif
+}
+
+/**
+ * @brief Creates a map with no dirty tile.
+ *
+ * @param width Width of the covered area in pixels.
+ * @param height Height of the covered area in pixels.
+ * @param tile_size Side of a tile in pixels. The area must be at most
+ * DIRTYMAP_MAX_COLS tiles wide.
+ * @return Pointer to the created DIRTY_MAP or NULL on failure.
+ */
+DIRTY_MAP *dirtymap_create(int width, int height, int tile_size) {
+  DIRTY_MAP *new_map = NULL;
+
+  if (width <= 0 || height <= 0 || tile_size <= 0 ||
+      (width + tile_size - 1) / tile_size > DIRTYMAP_MAX_COLS) {
+    return NULL;
+  }
+
+  new_map = (DIRTY_MAP *)malloc(sizeof(DIRTY_MAP));
+  if (!new_map) {
+    return NULL;
+  }
+
+  new_map->width = width;
+  new_map->height = height;
+  new_map->tile_size = tile_size;
+  new_map->cols = (width + tile_size - 1) / tile_size;
+  new_map->rows = (height + tile_size - 1) / tile_size;
+
+  new_map->mask = (uint64_t *)calloc(new_map->rows, sizeof(uint64_t));
+  new_map->work = (uint64_t *)malloc(new_map->rows * sizeof(uint64_t));
+  new_map->rects = (DIRTY_RECT *)malloc(new_map->cols * new_map->rows * sizeof(DIRTY_RECT));
+  if (!new_map->mask || !new_map->work || !new_map->rects) {
+    dirtymap_destroy(new_map);
+    return NULL;
+  }
+
+  return new_map;
+}
+
+/**
+ * @brief Destroys the map and frees its memory.
+ *
+ * @param map Pointer to the DIRTY_MAP to destroy.
+ * @return OK on success, ERROR if map is NULL.
+ */
+STATUS dirtymap_destroy(DIRTY_MAP *map) {
+  if (!map) {
+    return ERROR;
+  }
+
+  free(map->mask);
+  free(map->work);
+  free(map->rects);
+  free(map);
+
+  return OK;
+}
+
+/**
+ * @brief Marks every tile as clean.
+ *
+ * @param map Pointer to the DIRTY_MAP.
+ * @return OK on success, ERROR if map is NULL.
+ */
+STATUS dirtymap_clear(DIRTY_MAP *map) {
+  if (!map) {
+    return ERROR;
+  }
+
+  for (int r = 0; r < map->rows; r++) {
+    map->mask[r] = 0;
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Marks the tiles overlapped by a box as dirty.
+ *
+ * The box is clipped to the covered area; a box entirely outside it, or
+ * empty, marks nothing.
+ *
+ * @param map Pointer to the DIRTY_MAP.
+ * @param x X-coordinate of the box.
+ * @param y Y-coordinate of the box.
+ * @param width Width of the box in pixels.
+ * @param height Height of the box in pixels.
+ * @return OK on success, ERROR if map is NULL.
+ */
+STATUS dirtymap_mark(DIRTY_MAP *map, int x, int y, int width, int height) {
+  int x1 = x + width - 1;
+  int y1 = y + height - 1;
+  uint64_t run;
+
+  if (!map) {
+    return ERROR;
+  }
+
+  if (x < 0) x = 0;
+  if (y < 0) y = 0;
+  if (x1 >= map->width) x1 = map->width - 1;
+  if (y1 >= map->height) y1 = map->height - 1;
+
+  if (x > x1 || y > y1) {
+    return OK;
+  }
+
+  run = dirtymap_run(x / map->tile_size, x1 / map->tile_size);
+  for (int r = y / map->tile_size; r <= y1 / map->tile_size; r++) {
+    map->mask[r] |= run;
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Marks every tile as dirty.
+ *
+ * @param map Pointer to the DIRTY_MAP.
+ * @return OK on success, ERROR if map is NULL.
+ */
+STATUS dirtymap_mark_all(DIRTY_MAP *map) {
+  if (!map) {
+    return ERROR;
+  }
+
+  return dirtymap_mark(map, 0, 0, map->width, map->height);
+}
+
+/**
+ * @brief Marks as dirty every tile that is dirty in another map.
+ *
+ * @param map Pointer to the DIRTY_MAP to update.
+ * @param other Map with the same area and tile size.
+ * @return OK on success, ERROR if a map is NULL or their tiles differ.
+ */
+STATUS dirtymap_merge(DIRTY_MAP *map, const DIRTY_MAP *other) {
+  if (!map || !other || map->cols != other->cols || map->rows != other->rows) {
+    return ERROR;
+  }
+
+  for (int r = 0; r < map->rows; r++) {
+    map->mask[r] |= other->mask[r];
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Whether no tile is dirty.
+ *
+ * @param map Pointer to the DIRTY_MAP.
+ * @return true if every tile is clean or map is NULL, false otherwise.
+ */
+bool dirtymap_is_clean(const DIRTY_MAP *map) {
+  if (!map) {
+    return true;
+  }
+
+  for (int r = 0; r < map->rows; r++) {
+    if (map->mask[r]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Covers the dirty tiles with rectangles.
+ *
+ * Every dirty tile ends up in exactly one rectangle, and rectangles are
+ * clipped to the covered area. The tiles are left marked, so the map must
+ * be cleared before the next frame.
+ *
+ * @param map Pointer to the DIRTY_MAP.
+ * @param rects Set to the rectangles, owned by the map and valid until the
+ * next call.
+ * @return Number of rectangles, or 0 if map or rects is NULL.
+ */
+int dirtymap_rects(DIRTY_MAP *map, const DIRTY_RECT **rects) {
+  int n = 0;
+
+  if (!map || !rects) {
+    return 0;
+  }
+
+  // The greedy pass removes the tiles it covers, so it works on a copy
+  for (int r = 0; r < map->rows; r++) {
+    map->work[r] = map->mask[r];
+  }
+
+  for (int r = 0; r < map->rows; r++) {
+    while (map->work[r]) {
+      uint64_t row = map->work[r];
+      int c0 = dirtymap_first_bit(row);
+      int c1 = c0;
+      int r1 = r;
+
+      while (c1 + 1 < map->cols && (row >> (c1 + 1)) & 1) {
+        c1++;
+      }
+
+      // Grow down while the whole run is dirty below
+      uint64_t run = dirtymap_run(c0, c1);
+      while (r1 + 1 < map->rows && (map->work[r1 + 1] & run) == run) {
+        r1++;
+      }
+      for (int k = r; k <= r1; k++) {
+        map->work[k] &= ~run;
+      }
+
+      DIRTY_RECT *rect = &map->rects[n++];
+      rect->x = c0 * map->tile_size;
+      rect->y = r * map->tile_size;
+      rect->w = (c1 + 1) * map->tile_size;
+      rect->h = (r1 + 1) * map->tile_size;
+      if (rect->w > map->width) rect->w = map->width;
+      if (rect->h > map->height) rect->h = map->height;
+      rect->w -= rect->x;
+      rect->h -= rect->y;
+    }
+  }
+
+  *rects = map->rects;
+
+  return n;
+}
@@ -0,0 +1,262 @@
+/**
+ * @file drawlist.c
+ * @brief Implementation of the retained list of sprite draw commands.
+ *
+ * The commands are kept in a dense list. Submitting them fills a vertex
+ * array owned by the list with two triangles per sprite, so drawing never
+ * allocates. Consecutive sprites sharing a texture go out in one call;
+ * with every sprite in the atlas, that is the whole list.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#include "drawlist.h"
+#include "container.h"
+#include "sprite_inline.h"
+
+#define DRAWLIST_VERTICES_PER_CMD 6 ///< Two triangles per sprite
+
+DEFINE_DENSE_LIST(DRAW_CMD_LIST, draw_cmd_list, DRAW_CMD)
+
+/**
+ * @struct _drawlist
+ * @brief Commands of a frame plus the vertices they are turned into.
+ */
+struct _drawlist {
+  DRAW_CMD_LIST cmds;       ///< Commands in drawing order once sorted
+  ALLEGRO_VERTEX *vertices; ///< DRAWLIST_VERTICES_PER_CMD vertices per command
+};
+
+/**
+ * @brief Sort key of a command: layer first, then sprite.
+ */
+static inline int drawlist_key(const DRAW_CMD *cmd) {
+  return cmd->layer << 8 | cmd->sprite;
+}
+
+/**
+ * @brief Texture a sprite sheet is stored in.
+ *
+ * A sheet packed into the atlas is a sub-bitmap, and the texture is the
+ * atlas itself.
+ */
+static ALLEGRO_BITMAP *drawlist_texture(ALLEGRO_BITMAP *bitmap) {
+  ALLEGRO_BITMAP *parent = al_get_parent_bitmap(bitmap);
+
+  return parent ? parent : bitmap;
+}
+
+/**
+ * @brief Creates an empty draw list.
+ *
+ * @param capacity Maximum number of commands per frame.
+ * @return Pointer to the created DRAW_LIST or NULL on failure.
+ */
+DRAW_LIST *drawlist_create(int capacity) {
+  DRAW_LIST *new_list = NULL;
+
+  if (capacity <= 0) {
+    return NULL;
+  }
+
+  new_list = (DRAW_LIST *)malloc(sizeof(DRAW_LIST));
+  if (!new_list) {
+    return NULL;
+  }
+
+  draw_cmd_list_init(&new_list->cmds, (DRAW_CMD *)malloc(capacity * sizeof(DRAW_CMD)), capacity);
+  new_list->vertices = (ALLEGRO_VERTEX *)malloc(capacity * DRAWLIST_VERTICES_PER_CMD *
+                                                sizeof(ALLEGRO_VERTEX));
+  if (!new_list->cmds.items || !new_list->vertices) {
+    drawlist_destroy(new_list);
+    return NULL;
+  }
+
+  return new_list;
+}
+
+/**
+ * @brief Destroys the draw list and frees its memory.
+ *
+ * @param list Pointer to the DRAW_LIST to destroy.
+ * @return OK on success, ERROR if list is NULL.
+ */
+STATUS drawlist_destroy(DRAW_LIST *list) {
+  if (!list) {
+    return ERROR;
+  }
+
+  free(list->cmds.items);
+  free(list->vertices);
+  free(list);
+
+  return OK;
+}
+
+/**
+ * @brief Removes every command from the list.
+ *
+ * @param list Pointer to the DRAW_LIST.
+ * @return OK on success, ERROR if list is NULL.
+ */
+STATUS drawlist_clear(DRAW_LIST *list) {
+  if (!list) {
+    return ERROR;
+  }
+
+  draw_cmd_list_clear(&list->cmds);
+
+  return OK;
+}
+
+/**
+ * @brief Appends a command to the list.
+ *
+ * @param list Pointer to the DRAW_LIST.
+ * @param layer Layer the sprite is drawn in.
+ * @param sprite Sprite to draw.
+ * @param frame_x Column of the frame in the sprite sheet.
+ * @param frame_y Row of the frame in the sprite sheet.
+ * @param x X-coordinate on screen.
+ * @param y Y-coordinate on screen.
+ * @return OK on success, ERROR if an argument is invalid or the list is full.
+ */
+STATUS drawlist_push(DRAW_LIST *list, DRAW_LAYER layer, SPRITE_ID sprite, int frame_x, int frame_y,
+                     FIXED x, FIXED y) {
+  DRAW_CMD cmd;
+
+  if (!list || layer >= NUM_LAYERS || sprite >= NUM_SPRITES) {
+    return ERROR;
+  }
+
+  cmd.layer = (uint8_t)layer;
+  cmd.sprite = (uint8_t)sprite;
+  cmd.frame_x = (uint8_t)frame_x;
+  cmd.frame_y = (uint8_t)frame_y;
+  cmd.x = x;
+  cmd.y = y;
+
+  return draw_cmd_list_push(&list->cmds, cmd);
+}
+
+/**
+ * @brief Gets the number of commands in the list.
+ *
+ * @param list Pointer to the DRAW_LIST.
+ * @return Number of commands, or 0 if list is NULL.
+ */
+int drawlist_size(const DRAW_LIST *list) {
+  if (!list) {
+    return 0;
+  }
+
+  return draw_cmd_list_size(&list->cmds);
+}
+
+/**
+ * @brief Gets the command at position i.
+ *
+ * @param list Pointer to the DRAW_LIST.
+ * @param i Position of the command, in [0, drawlist_size(list)).
+ * @return Pointer to the command, or NULL if list is NULL or i is out of range.
+ */
+const DRAW_CMD *drawlist_at(const DRAW_LIST *list, int i) {
+  if (!list || i < 0 || i >= list->cmds.size) {
+    return NULL;
+  }
+
+  return &list->cmds.items[i];
+}
+
+/**
+ * @brief Sorts the commands by layer, then by sprite.
+ *
+ * Sprites of a layer never overlap each other in a way that matters, so
+ * grouping them by sprite is free and puts the commands that share a
+ * texture next to each other. The sort is stable, so commands of the same
+ * layer and sprite keep the order they were pushed in.
+ *
+ * @param list Pointer to the DRAW_LIST.
+ * @return OK on success, ERROR if list is NULL.
+ */
+STATUS drawlist_sort(DRAW_LIST *list) {
+  if (!list) {
+    return ERROR;
+  }
+
+  // Insertion sort: the game pushes the commands almost in order already
+  for (int i = 1; i < list->cmds.size; i++) {
+    DRAW_CMD cmd = list->cmds.items[i];
+    int key = drawlist_key(&cmd);
+    int k = i;
+
+    while (k > 0 && drawlist_key(&list->cmds.items[k - 1]) > key) {
+      list->cmds.items[k] = list->cmds.items[k - 1];
+      k--;
+    }
+    list->cmds.items[k] = cmd;
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Draws every command of the list.
+ *
+ * Each command becomes a textured quad with pixel texture coordinates in
+ * its sheet's texture. A run of commands using the same texture is sent
+ * with a single al_draw_prims() call. Commands whose sprite is not
+ * registered are skipped.
+ *
+ * @param list Pointer to the DRAW_LIST.
+ * @return OK on success, ERROR if list is NULL.
+ */
+STATUS drawlist_submit(DRAW_LIST *list) {
+  ALLEGRO_COLOR white = al_map_rgb(255, 255, 255);
+  ALLEGRO_BITMAP *texture = NULL;
+  int start = 0, end = 0;
+
+  if (!list) {
+    return ERROR;
+  }
+
+  for (int i = 0; i < list->cmds.size; i++) {
+    const DRAW_CMD *cmd = &list->cmds.items[i];
+    const SPRITE *sprite = &sprite_table[cmd->sprite];
+    ALLEGRO_VERTEX *v = &list->vertices[end];
+
+    if (!sprite->bitmap) {
+      continue;
+    }
+
+    // A new texture closes the current run
+    if (drawlist_texture(sprite->bitmap) != texture) {
+      if (end > start) {
+        al_draw_prims(list->vertices, NULL, texture, start, end, ALLEGRO_PRIM_TRIANGLE_LIST);
+      }
+      texture = drawlist_texture(sprite->bitmap);
+      start = end;
+    }
+
+    float x0 = FIXED_TO_FLOAT(cmd->x), y0 = FIXED_TO_FLOAT(cmd->y);
+    float x1 = x0 + sprite->width, y1 = y0 + sprite->height;
+    float u0 = al_get_bitmap_x(sprite->bitmap) + cmd->frame_x * sprite->width;
+    float v0 = al_get_bitmap_y(sprite->bitmap) + cmd->frame_y * sprite->height;
+    float u1 = u0 + sprite->width, v1 = v0 + sprite->height;
+
+    v[0] = (ALLEGRO_VERTEX){x0, y0, 0, u0, v0, white};
+    v[1] = (ALLEGRO_VERTEX){x1, y0, 0, u1, v0, white};
+    v[2] = (ALLEGRO_VERTEX){x1, y1, 0, u1, v1, white};
+    v[3] = (ALLEGRO_VERTEX){x0, y0, 0, u0, v0, white};
+    v[4] = (ALLEGRO_VERTEX){x1, y1, 0, u1, v1, white};
+    v[5] = (ALLEGRO_VERTEX){x0, y1, 0, u0, v1, white};
+    end += DRAWLIST_VERTICES_PER_CMD;
+  }
+
+  if (end > start) {
+    al_draw_prims(list->vertices, NULL, texture, start, end, ALLEGRO_PRIM_TRIANGLE_LIST);
+  }
+
+  return OK;
+}
@@ -0,0 +1,723 @@
+/**
+ * @file formation.c
+ * @brief Implementation of the martian Formation and its associated functions.
+ *
+ * The formation keeps the martians as a structure of arrays: a single
+ * origin shared by every martian and one 64-bit alive mask per column.
+ * Cell coordinates are derived from the origin and the fixed spacing
+ * between martians, so moving the fleet only touches the origin, and the
+ * front martian of a column is the highest set bit of its mask.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#include "formation_inline.h"
+#include "sprite_inline.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Returns the index of the highest set bit of a non-zero mask.
+ *
+ * Compiles to a single count-leading-zeros instruction where available.
+ *
+ * @param mask Non-zero 64-bit mask.
+ * @return Bit index in [0, 63].
+ */
+static int form_highest_bit(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+  return 63 - __builtin_clzll(mask);
+#elif defined(_MSC_VER) && defined(_WIN64)
+  unsigned long index;
+  _BitScanReverse64(&index, mask);
+  return (int)index;
+#else
+  int bit = 0;
+  while (mask >>= 1) {
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+/**
+ * @brief Divides a fixed-point offset by a cell pitch, rounding towards minus infinity.
+ *
+ * @param offset Offset from the formation origin.
+ * @param pitch Cell pitch in pixels (positive).
+ * @return Index of the cell containing the offset (may be out of range).
+ */
+static int form_cell_floor(FIXED offset, int pitch) {
+  FIXED step = INT_TO_FIXED(pitch);
+  int cell = offset / step;
+
+  if (offset % step != 0 && offset < 0) {
+    cell--;
+  }
+
+  return cell;
+}
+
+/**
+ * @brief Returns the sprite row (martian type) used by a formation row.
+ *
+ * The top row holds the squids, the next two the crabs and the rest
+ * the octopuses, as in the arcade.
+ *
+ * @param row Row index inside the formation.
+ * @return Source y-coordinate in the sprite sheet.
+ */
+static int form_row_type(int row) {
+  if (row == 0) {
+    return 0;
+  } else if (row <= 2) {
+    return 1;
+  }
+
+  return 2;
+}
+
+/**
+ * @brief Creates a new formation with all cells dead.
+ *
+ * Martians are drawn from SPRITE_MARTIAN, which also gives their size.
+ *
+ * @param cols Number of martians per row.
+ * @param rows Number of martians per column.
+ * @return Pointer to the created FORMATION or NULL on failure.
+ */
+FORMATION *form_create(int cols, int rows) {
+  FORMATION *new_formation = NULL;
+
+  // One bit per row in the column masks
+  if (cols <= 0 || rows <= 0 || rows > MAX_FORMATION_ROWS) {
+    return NULL;
+  }
+
+  new_formation = (FORMATION *)malloc(sizeof(FORMATION));
+  if (!new_formation) {
+    return NULL;
+  }
+
+  new_formation->col_mask = (uint64_t *)calloc(cols, sizeof(uint64_t));
+  column_list_init(&new_formation->live_cols, (int *)calloc(cols, sizeof(int)), cols);
+  new_formation->live_col_pos = (int *)calloc(cols, sizeof(int));
+  new_formation->row_count = (int *)calloc(rows, sizeof(int));
+  if (!new_formation->col_mask || !new_formation->live_cols.items ||
+      !new_formation->live_col_pos || !new_formation->row_count) {
+    form_destroy(new_formation);
+    return NULL;
+  }
+
+  for (int col = 0; col < cols; col++) {
+    new_formation->live_col_pos[col] = -1;
+  }
+
+  // Empty box until the formation is reset
+  new_formation->min_col = cols;
+  new_formation->max_col = -1;
+  new_formation->max_row = -1;
+
+  new_formation->x = 0;
+  new_formation->y = 0;
+
+  new_formation->dir = RIGHT;
+
+  new_formation->source_x = 0;
+
+  new_formation->cols = cols;
+  new_formation->rows = rows;
+
+  return new_formation;
+}
+
+/**
+ * @brief Destroys the formation and frees its memory.
+ *
+ * @param formation Pointer to the FORMATION to destroy.
+ * @return OK on success, ERROR if formation is NULL.
+ */
+STATUS form_destroy(FORMATION *formation) {
+  if (!formation) {
+    return ERROR;
+  }
+
+  free(formation->col_mask);
+  free(formation->live_cols.items);
+  free(formation->live_col_pos);
+  free(formation->row_count);
+  free(formation);
+
+  return OK;
+}
+
+/**
+ * @brief Revives every cell and places the formation at (x, y).
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param x X-coordinate of the top-left martian.
+ * @param y Y-coordinate of the top-left martian.
+ * @return OK on success, ERROR if formation is NULL.
+ */
+STATUS form_reset(FORMATION *formation, FIXED x, FIXED y) {
+  if (!formation) {
+    return ERROR;
+  }
+
+  formation->x = x;
+  formation->y = y;
+  formation->dir = RIGHT;
+  formation->source_x = 0;
+
+  uint64_t full = (formation->rows == 64) ? ~(uint64_t)0
+                                          : (((uint64_t)1 << formation->rows) - 1);
+
+  column_list_clear(&formation->live_cols);
+
+  for (int col = 0; col < formation->cols; col++) {
+    formation->col_mask[col] = full;
+    formation->live_col_pos[col] = column_list_size(&formation->live_cols);
+    column_list_push(&formation->live_cols, col);
+  }
+
+  for (int row = 0; row < formation->rows; row++) {
+    formation->row_count[row] = formation->cols;
+  }
+
+  formation->min_col = 0;
+  formation->max_col = formation->cols - 1;
+  formation->max_row = formation->rows - 1;
+
+  return OK;
+}
+
+/**
+ * @brief Sets the x-coordinate of the formation origin.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param x New x-coordinate.
+ * @return OK on success, ERROR if formation is NULL.
+ */
+STATUS form_set_x(FORMATION *formation, FIXED x) {
+  if (!formation) {
+    return ERROR;
+  }
+
+  formation->x = x;
+
+  return OK;
+}
+
+/**
+ * @brief Gets the x-coordinate of the formation origin.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return X-coordinate, or 0 if formation is NULL.
+ */
+FIXED form_get_x(FORMATION *formation) {
+  if (!formation) {
+    return 0;
+  }
+
+  return formation->x;
+}
+
+/**
+ * @brief Sets the y-coordinate of the formation origin.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param y New y-coordinate.
+ * @return OK on success, ERROR if formation is NULL.
+ */
+STATUS form_set_y(FORMATION *formation, FIXED y) {
+  if (!formation) {
+    return ERROR;
+  }
+
+  formation->y = y;
+
+  return OK;
+}
+
+/**
+ * @brief Gets the y-coordinate of the formation origin.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return Y-coordinate, or 0 if formation is NULL.
+ */
+FIXED form_get_y(FORMATION *formation) {
+  if (!formation) {
+    return 0;
+  }
+
+  return formation->y;
+}
+
+/**
+ * @brief Sets the movement direction of the formation.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param dir New direction.
+ * @return OK on success, ERROR if formation is NULL.
+ */
+STATUS form_set_dir(FORMATION *formation, int dir) {
+  if (!formation) {
+    return ERROR;
+  }
+
+  formation->dir = dir;
+
+  return OK;
+}
+
+/**
+ * @brief Gets the movement direction of the formation.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return Current direction, or NO_DIR if formation is NULL.
+ */
+int form_get_dir(FORMATION *formation) {
+  if (!formation) {
+    return NO_DIR;
+  }
+
+  return formation->dir;
+}
+
+/**
+ * @brief Gets the number of martians per row.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return Number of columns, or 0 if formation is NULL.
+ */
+int form_get_cols(FORMATION *formation) {
+  if (!formation) {
+    return 0;
+  }
+
+  return formation->cols;
+}
+
+/**
+ * @brief Gets the number of martians per column.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return Number of rows, or 0 if formation is NULL.
+ */
+int form_get_rows(FORMATION *formation) {
+  if (!formation) {
+    return 0;
+  }
+
+  return formation->rows;
+}
+
+/**
+ * @brief Gets the total number of cells of the formation.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return cols * rows, or 0 if formation is NULL.
+ */
+int form_get_size(FORMATION *formation) {
+  if (!formation) {
+    return 0;
+  }
+
+  return formation->cols * formation->rows;
+}
+
+/**
+ * @brief Checks if the martian in cell i is alive.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param i Cell index.
+ * @return true if the cell holds a live martian, false otherwise.
+ */
+bool form_is_alive(FORMATION *formation, int i) {
+  if (!formation || i < 0 || i >= formation->cols * formation->rows) {
+    return false;
+  }
+
+  return (formation->col_mask[i % formation->cols] >> (i / formation->cols)) & 1;
+}
+
+/**
+ * @brief Marks the martian in cell i as dead.
+ *
+ * Clears the cell bit in its column mask. When the column becomes empty
+ * it is swapped out of the dense list of live columns. The bounding box
+ * then shrinks past any edge column or bottom row left empty; each edge
+ * only ever moves inwards, so the cost is amortized over the wave.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param i Cell index.
+ * @return OK on success, ERROR if formation is NULL or the cell is invalid.
+ */
+STATUS form_kill(FORMATION *formation, int i) {
+  if (!formation || i < 0 || i >= formation->cols * formation->rows) {
+    return ERROR;
+  }
+
+  int col = i % formation->cols;
+  int row = i / formation->cols;
+  uint64_t bit = (uint64_t)1 << row;
+
+  // Killing a dead cell must not touch the row counts
+  if (!(formation->col_mask[col] & bit)) {
+    return OK;
+  }
+
+  formation->col_mask[col] &= ~bit;
+  formation->row_count[row]--;
+
+  if (formation->col_mask[col] == 0 && formation->live_col_pos[col] >= 0) {
+    int pos = formation->live_col_pos[col];
+
+    column_list_remove_at(&formation->live_cols, pos);
+    formation->live_col_pos[col] = -1;
+
+    // The former last column now sits at pos
+    if (pos < column_list_size(&formation->live_cols)) {
+      formation->live_col_pos[*column_list_at(&formation->live_cols, pos)] = pos;
+    }
+
+    while (formation->min_col <= formation->max_col &&
+           formation->col_mask[formation->min_col] == 0) {
+      formation->min_col++;
+    }
+
+    while (formation->max_col >= formation->min_col &&
+           formation->col_mask[formation->max_col] == 0) {
+      formation->max_col--;
+    }
+  }
+
+  while (formation->max_row >= 0 && formation->row_count[formation->max_row] == 0) {
+    formation->max_row--;
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Checks if every martian of the formation is dead.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return true if no cell is alive or formation is NULL, false otherwise.
+ */
+bool form_is_empty(FORMATION *formation) {
+  if (!formation) {
+    return true;
+  }
+
+  return column_list_size(&formation->live_cols) == 0;
+}
+
+/**
+ * @brief Gets the x-coordinate of the leftmost live column.
+ *
+ * Only meaningful while the formation is not empty.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return X-coordinate, or 0 if formation is NULL.
+ */
+FIXED form_get_left(FORMATION *formation) {
+  if (!formation) {
+    return 0;
+  }
+
+  return formation->x + INT_TO_FIXED(formation->min_col * SPACE_BTW_MARTIANS_X);
+}
+
+/**
+ * @brief Gets the x-coordinate of the rightmost live column.
+ *
+ * Only meaningful while the formation is not empty.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return X-coordinate, or 0 if formation is NULL.
+ */
+FIXED form_get_right(FORMATION *formation) {
+  if (!formation) {
+    return 0;
+  }
+
+  return formation->x + INT_TO_FIXED(formation->max_col * SPACE_BTW_MARTIANS_X);
+}
+
+/**
+ * @brief Gets the y-coordinate of the lowest live row.
+ *
+ * Only meaningful while the formation is not empty.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return Y-coordinate, or 0 if formation is NULL.
+ */
+FIXED form_get_bottom(FORMATION *formation) {
+  if (!formation) {
+    return 0;
+  }
+
+  return formation->y + INT_TO_FIXED(formation->max_row * SPACE_BTW_MARTIANS_Y);
+}
+
+/**
+ * @brief Gets the front (lowest alive) martian of a column.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param col Column index.
+ * @return Cell index of the front martian, or -1 if the column is empty.
+ */
+int form_get_front_cell(FORMATION *formation, int col) {
+  if (!formation || col < 0 || col >= formation->cols ||
+      formation->col_mask[col] == 0) {
+    return -1;
+  }
+
+  return form_highest_bit(formation->col_mask[col]) * formation->cols + col;
+}
+
+/**
+ * @brief Picks a random front-row martian in constant time.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param rand_value Random value used to choose among the live columns.
+ * @return Cell index of the shooter, or -1 if no martian is alive.
+ */
+int form_get_random_shooter(FORMATION *formation, int rand_value) {
+  if (!formation || column_list_size(&formation->live_cols) <= 0) {
+    return -1;
+  }
+
+  int col = *column_list_at(&formation->live_cols,
+                            rand_value % column_list_size(&formation->live_cols));
+
+  return form_get_front_cell(formation, col);
+}
+
+/**
+ * @brief Finds the alive martian overlapped by a box, from the cell pitch.
+ *
+ * The box is mapped to the range of cells it can touch by dividing its
+ * offset from the formation origin by the cell pitch. Only those cells,
+ * usually one or two, are tested, so the cost does not depend on the
+ * size of the formation.
+ *
+ * When several cells overlap the box, the lowest one on screen is returned
+ * (the first one met by a bullet travelling up), leftmost on ties.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param x X-coordinate of the box.
+ * @param y Y-coordinate of the box.
+ * @param width Width of the box in pixels.
+ * @param height Height of the box in pixels.
+ * @return Index of the overlapped alive cell, or -1 if there is none.
+ */
+int form_hit_test(FORMATION *formation, FIXED x, FIXED y, int width, int height) {
+  if (!formation) {
+    return -1;
+  }
+
+  FIXED dx = x - formation->x;
+  FIXED dy = y - formation->y;
+  int cell_width = sprite_width(SPRITE_MARTIAN);
+  int cell_height = sprite_height(SPRITE_MARTIAN);
+
+  // A cell can only be hit if it starts before the box ends and ends after it starts
+  int c0 = form_cell_floor(dx - INT_TO_FIXED(cell_width), SPACE_BTW_MARTIANS_X);
+  int c1 = form_cell_floor(dx + INT_TO_FIXED(width), SPACE_BTW_MARTIANS_X);
+  int r0 = form_cell_floor(dy - INT_TO_FIXED(cell_height), SPACE_BTW_MARTIANS_Y);
+  int r1 = form_cell_floor(dy + INT_TO_FIXED(height), SPACE_BTW_MARTIANS_Y);
+
+  if (c0 < 0) c0 = 0;
+  if (r0 < 0) r0 = 0;
+  if (c1 >= formation->cols) c1 = formation->cols - 1;
+  if (r1 >= formation->rows) r1 = formation->rows - 1;
+
+  for (int r = r1; r >= r0; r--) {
+    for (int c = c0; c <= c1; c++) {
+      if (!((formation->col_mask[c] >> r) & 1)) {
+        continue;
+      }
+
+      FIXED cx = formation->x + INT_TO_FIXED(c * SPACE_BTW_MARTIANS_X);
+      FIXED cy = formation->y + INT_TO_FIXED(r * SPACE_BTW_MARTIANS_Y);
+
+      if (x < cx + INT_TO_FIXED(cell_width) && x + INT_TO_FIXED(width) > cx &&
+          y < cy + INT_TO_FIXED(cell_height) && y + INT_TO_FIXED(height) > cy) {
+        return r * formation->cols + c;
+      }
+    }
+  }
+
+  return -1;
+}
+
+/**
+ * @brief Gets the screen x-coordinate of cell i.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param i Cell index.
+ * @return X-coordinate, or 0 if formation is NULL.
+ */
+FIXED form_get_cell_x(FORMATION *formation, int i) {
+  if (!formation) {
+    return 0;
+  }
+
+  return formation->x + INT_TO_FIXED((i % formation->cols) * SPACE_BTW_MARTIANS_X);
+}
+
+/**
+ * @brief Gets the screen y-coordinate of cell i.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param i Cell index.
+ * @return Y-coordinate, or 0 if formation is NULL.
+ */
+FIXED form_get_cell_y(FORMATION *formation, int i) {
+  if (!formation) {
+    return 0;
+  }
+
+  return formation->y + INT_TO_FIXED((i / formation->cols) * SPACE_BTW_MARTIANS_Y);
+}
+
+/**
+ * @brief Gets the score awarded for destroying the martian in cell i.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param i Cell index.
+ * @return Score value, or -1 if formation is NULL.
+ */
+int form_get_cell_score(FORMATION *formation, int i) {
+  static const int scores[] = {POINTS_01, POINTS_02, POINTS_03};
+
+  if (!formation) {
+    return -1;
+  }
+
+  return scores[form_row_type(i / formation->cols)];
+}
+
+/**
+ * @brief Sets the shared animation frame of all martians.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param source_x Frame index in the sprite sheet.
+ * @return OK on success, ERROR if formation is NULL.
+ */
+STATUS form_set_source_x(FORMATION *formation, int source_x) {
+  if (!formation) {
+    return ERROR;
+  }
+
+  formation->source_x = source_x;
+
+  return OK;
+}
+
+/**
+ * @brief Gets the shared animation frame of all martians.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return Frame index, or -1 if formation is NULL.
+ */
+int form_get_source_x(FORMATION *formation) {
+  if (!formation) {
+    return -1;
+  }
+
+  return formation->source_x;
+}
+
+/**
+ * @brief Gets the width of a martian.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return Width, or 0 if formation is NULL.
+ */
+int form_get_width(FORMATION *formation) {
+  if (!formation) {
+    return 0;
+  }
+
+  return sprite_width(SPRITE_MARTIAN);
+}
+
+/**
+ * @brief Gets the height of a martian.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @return Height, or 0 if formation is NULL.
+ */
+int form_get_height(FORMATION *formation) {
+  if (!formation) {
+    return 0;
+  }
+
+  return sprite_height(SPRITE_MARTIAN);
+}
+
+/**
+ * @brief Moves the formation one step in its current direction.
+ *
+ * Lateral steps advance by speed; a downward step drops the whole block
+ * by one martian height.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param speed Horizontal step size.
+ * @return OK on success, ERROR if formation is NULL.
+ */
+STATUS form_move(FORMATION *formation, FIXED speed) {
+  if (!formation) {
+    return ERROR;
+  }
+
+  if (formation->dir == RIGHT) {
+    formation->x += speed;
+  } else if (formation->dir == LEFT) {
+    formation->x -= speed;
+  } else if (formation->dir == DOWN) {
+    formation->y += INT_TO_FIXED(MART_HEIGHT);
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Appends every alive martian of the formation to a draw list.
+ *
+ * The martians are drawn from SPRITE_MARTIAN.
+ *
+ * @param formation Pointer to the FORMATION.
+ * @param list Draw list of the frame.
+ * @param layer Layer the martians are drawn in.
+ * @return OK on success, ERROR if formation is NULL or the list is full.
+ */
+STATUS form_queue_draw(FORMATION *formation, DRAW_LIST *list, DRAW_LAYER layer) {
+  if (!formation) {
+    return ERROR;
+  }
+
+  for (int row = 0; row < formation->rows; row++) {
+    FIXED y = formation->y + INT_TO_FIXED(row * SPACE_BTW_MARTIANS_Y);
+    int source_y = form_row_type(row);
+
+    for (int col = 0; col < formation->cols; col++) {
+      if (!((formation->col_mask[col] >> row) & 1)) {
+        continue;
+      }
+
+      if (drawlist_push(list, layer, SPRITE_MARTIAN, formation->source_x, source_y,
+                        formation->x + INT_TO_FIXED(col * SPACE_BTW_MARTIANS_X), y) == ERROR) {
+        return ERROR;
+      }
+    }
+  }
+
+  return OK;
+}
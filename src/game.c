@@ -11,46 +11,145 @@
  */
 
 #include "game.h"
+#include "aabb.h"
+#include "atlas.h"
+#include "bullet_inline.h"
+#include "bunker_inline.h"
+#include "container.h"
+#include "dirtymap.h"
+#include "drawlist.h"
+#include "formation_inline.h"
+#include "slotmap_inline.h"
+#include "sprite_inline.h"
+#include "textcache.h"
+#include "triplebuf.h"
 #include <allegro5/allegro_acodec.h>
 #include <allegro5/allegro_audio.h>
+#include <limits.h>
 #include <stdio.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
 
 typedef enum { STATE_TITLE, STATE_PLAYING, STATE_GAME_OVER, STATE_WIN, STATE_HIGHSCORE_ENTRY } GAME_STATE;
 
+// IDs of the collision grid: bunkers, then bullets. Martians are found
+// from the formation pitch instead (form_hit_test)
+#define GRID_ID_BUNKER(j) (j)
+#define GRID_ID_BULLET(i) (NUM_BUNKERS + (i))
+#define GRID_MAX_ID GRID_ID_BULLET(MAX_BULLETS)
+#define GRID_SPAN(size) ((size) / GRID_CELL_SIZE + 2) ///< Most cells a box of this size spans
+#define GRID_MAX_NODES                                                                        \
+  (NUM_BUNKERS * GRID_SPAN(BUNKER_WIDTH) * GRID_SPAN(BUNKER_HEIGHT) + MAX_BULLETS * 4)
+
+// Area redrawn when a HUD number changes (dirty rectangles)
+#define HUD_VALUE_WIDTH 96
+#define HUD_VALUE_HEIGHT 24
+#define HUD_TOP 112 ///< Band of the screen holding the HUD text
+#define HUD_BOTTOM (140 + HUD_VALUE_HEIGHT)
+
 /**
- * @struct _game
- * @brief Main game structure containing all game components and state
- * variables.
+ * @brief Slot of each line of text in the text cache.
  *
- * Holds the display, bitmaps, timers, and other components necessary to run
- * the game. It manages player actions, enemies, bullets, and other objects in
- * the game world.
+ * Every line drawn on screen has its own slot, so a line is rendered again
+ * only when its own text changes.
  */
-struct _game {
-  ALLEGRO_DISPLAY *screen;                 ///< Main display
-  ALLEGRO_BITMAP *background;              ///< Background image
-  ALLEGRO_BITMAP *frame;                   ///< Frame surrounding the screen
-  ALLEGRO_BITMAP *ship_img;                ///< Player ship image
-  ALLEGRO_BITMAP *ship_bullet_img;         ///< Image for the player's bullets
-  ALLEGRO_BITMAP *martian_img;             ///< Image for martians
-  ALLEGRO_BITMAP *martian_explosion_img;   ///< Image for martian explosions
-  ALLEGRO_BITMAP *martian_bullet_img;      ///< Image for martian bullets
-  ALLEGRO_BITMAP *bunker_img;              ///< Image for bunkers
-  ALLEGRO_BITMAP *ufo_img;                 ///< Image for UFO
-  ALLEGRO_FONT *font;                      ///< Font used in the game
+typedef enum {
+  TEXT_LIVES,
+  TEXT_SCORE_LABEL,
+  TEXT_SCORE,
+  TEXT_HIGH_SCORE_LABEL,
+  TEXT_HIGH_SCORE,
+  TEXT_LEVEL_LABEL,
+  TEXT_LEVEL,
+  TEXT_TITLE,
+  TEXT_PRESS_ENTER,
+  TEXT_ENTER_ARROWS,
+  TEXT_TOP_SCORES,
+  TEXT_TOP_SCORE,                                  ///< First of MAX_TOP_SCORES table lines
+  TEXT_PAUSED = TEXT_TOP_SCORE + MAX_TOP_SCORES,
+  TEXT_PAUSED_HINT,
+  TEXT_GAME_OVER,
+  TEXT_GAME_OVER_SCORE,
+  TEXT_GAME_OVER_HINT,
+  TEXT_WAVE_CLEARED,
+  TEXT_WAVE_CLEARED_HINT,
+  TEXT_NEW_HIGH_SCORE,
+  TEXT_ENTRY_SCORE,
+  TEXT_ENTRY_PROMPT,
+  TEXT_ENTRY_INITIALS,
+  TEXT_ENTRY_CURSOR,
+  TEXT_ENTRY_EDIT_HINT,
+  TEXT_ENTRY_SAVE_HINT,
+  NUM_TEXT_SLOTS
+} TEXT_SLOT;
 
-  ALLEGRO_TIMER *timer;                    ///< Main game timer
-  ALLEGRO_EVENT_QUEUE *event_queue;        ///< Event queue for managing game events
-  ALLEGRO_EVENT events;                    ///< Structure to store current event
+/**
+ * @brief Kind of target a bullet can collide with.
+ */
+typedef enum { HIT_NONE, HIT_MARTIAN, HIT_BULLET, HIT_UFO, HIT_BUNKER, HIT_SHIP } HIT_KIND;
 
-  SHIP *ship;                              ///< Player ship instance
-  MARTIAN *enemy[MAX_ENEMIES];             ///< Array of enemy instances
-  BULLET *orphan_bullets[MAX_ORP_BULLETS]; ///< Array of bullets without an owner
-  OBJECT *objects[MAX_OBJECTS];            ///< Array of other objects in the game
-  BUNKER *bunkers[NUM_BUNKERS * BUNKER_PARTS]; ///< Array of bunker parts (BUNKER_PARTS pieces per bunker)
+/**
+ * @brief Earliest target met by a bullet during its last move.
+ */
+typedef struct {
+  HIT_KIND kind;  ///< What was hit, HIT_NONE if nothing
+  int index;      ///< Martian cell, bullet slot or bunker (unused for the UFO and ship)
+  FIXED distance; ///< Distance the bullet travelled before touching the target
+} HIT;
 
-  float FPS;                               ///< Frames per second for the game
+/**
+ * @brief Next tick at which a bullet must be tested for collisions.
+ */
+typedef struct {
+  unsigned tick;      ///< Value of bullet_tick at which the bullet is due
+  SLOT_HANDLE bullet; ///< Bullet to test; stale once the bullet is gone
+} BULLET_DUE;
+
+/**
+ * @brief Orders the impact schedule by due tick.
+ */
+static inline bool bullet_due_before(const BULLET_DUE *a, const BULLET_DUE *b) {
+  return a->tick < b->tick;
+}
+
+DEFINE_MIN_HEAP(BULLET_SCHEDULE, bullet_schedule, BULLET_DUE, bullet_due_before)
+
+#define BULLET_SCHEDULE_SIZE (MAX_BULLETS * 2) ///< Live entries plus room for stale ones
+#define BULLET_NEVER_DUE UINT_MAX              ///< No static target on the bullet's path
+
+// Every sprite of a frame: martians, bunkers, ship, UFO, bullets,
+// explosions and the life icons (with the extra life)
+#define DRAW_LIST_SIZE                                                                        \
+  (MAX_ENEMIES + NUM_BUNKERS + 2 + MAX_BULLETS + MAX_OBJECTS + SHIP_LIFE + 1)
+
+/**
+ * @brief Hit recorded by the collision pass, applied by the passes after it.
+ */
+typedef struct {
+  uint8_t kind;   ///< What was hit (HIT_KIND)
+  int16_t bullet; ///< Slot of the bullet that hit
+  int16_t index;  ///< Martian cell, bullet slot or bunker
+  FIXED x, y;     ///< Position of the target when it was hit (impact point for bunkers)
+} HIT_EVENT;
+
+_Static_assert(MAX_ENEMIES <= INT16_MAX, "a martian cell must fit in HIT_EVENT.index");
+_Static_assert(MAX_BULLETS <= INT16_MAX, "a bullet slot must fit in HIT_EVENT.bullet");
+
+/**
+ * @brief Simulation state that game_update() reads and writes every tick.
+ *
+ * Plain data only (no pointers), aligned to a cache line and placed at the
+ * start of struct _game, so a tick touches as few lines as possible and the
+ * whole block can be copied as a snapshot.
+ */
+typedef struct {
+  _Alignas(CACHE_LINE_SIZE) GAME_STATE state; ///< Current game state
   bool done, draw;                         ///< Flags to track game state
+  bool paused;                             ///< Pause state
+  bool p_was_down;                         ///< Previous pause input for edge-detection
+  bool ship_exploding;                     ///< Flag for ship death animation
+  bool extra_life_1500_awarded;            ///< Extra life at 1500 points awarded
 
   int num_enemies_destroyed;               ///< Number of destroyed enemies
   int num_enemies_alive;                   ///< Number of remaining enemies
@@ -58,39 +157,136 @@ struct _game {
   int enemy_shoot_timer;                   ///< Timer for enemy shooting frequency
   int enemy_animation_timer;               ///< Timer for enemy animation
   int enemy_move_timer;                    ///< Timer for enemy movement
-  float enemies_dir;                       ///< Direction of enemy movement
+  int level_start_delay;                   ///< Delay before enemies shoot at level start
 
-  int num_orphan_bullets;                  ///< Count of orphaned bullets
-  int num_objects;                         ///< Count of other game objects
+  int num_ship_bullets;                    ///< Bullets in flight fired by the player
+  unsigned bullet_tick;                    ///< Bullet moves so far (clock of the impact schedule)
+  int ship_explosion_timer;                ///< Timer for death animation
 
-  OBJECT *ufo;                             ///< Mystery ship (UFO)
   int ufo_timer;                           ///< Timer for UFO spawn
   int ufo_dir;                             ///< Direction of UFO movement (-1: left, 1: right)
 
-  ALLEGRO_SAMPLE *samples[10];             ///< Sound samples for the game
-
   int total_score;                         ///< Player's total score
+  uint32_t rng;                            ///< State of the game's random generator
   int level;                               ///< Current wave/level number (starts at 1)
   int level_y_offset;                      ///< Extra Y pixels enemies start lower each wave
+  int title_timer;                         ///< Timer for title screen animation
+} GAME_SIM;
+
+/**
+ * @brief Display, loaded resources and event handling. Only touched when
+ * loading, drawing, playing sounds or waiting for events.
+ */
+typedef struct {
+  ALLEGRO_DISPLAY *screen;                 ///< Main display
+  ALLEGRO_BITMAP *background;              ///< Background image
+  ALLEGRO_BITMAP *frame;                   ///< Frame surrounding the screen
+  ALLEGRO_BITMAP *ship_img;                ///< Player ship image
+  ALLEGRO_BITMAP *ship_bullet_img;         ///< Image for the player's bullets
+  ALLEGRO_BITMAP *martian_img;             ///< Image for martians
+  ALLEGRO_BITMAP *martian_explosion_img;   ///< Image for martian explosions
+  ALLEGRO_BITMAP *martian_bullet_img;      ///< Image for martian bullets
+  ALLEGRO_BITMAP *bunker_img;              ///< Image for bunkers
+  ALLEGRO_BITMAP *ufo_img;                 ///< Image for UFO
+  ATLAS *atlas;                            ///< Texture holding every sprite image above
+  ALLEGRO_BITMAP *bunker_image;            ///< Atlas region holding the image of every bunker
+  ALLEGRO_BITMAP *scene;                   ///< Background, bunkers, floor and frame composited
+  bool scene_valid;                        ///< scene matches the bunkers and scene_floor
+  bool scene_floor;                        ///< Whether scene was composited with the floor
+  bool dirty_rects;                        ///< Redraw only the areas that changed
+  ALLEGRO_BITMAP *canvas;                  ///< Last frame presented, kept for dirty rectangles
+  bool canvas_valid;                       ///< canvas can be patched instead of redrawn
+  DIRTY_MAP *dirty;                        ///< Areas to redraw this frame
+  DIRTY_MAP *sprites;                      ///< Tiles covered by this frame's sprites
+  DIRTY_MAP *prev_sprites;                 ///< Tiles covered by the previous frame's sprites
+  int hud_score, hud_high_score, hud_level; ///< HUD numbers shown on canvas
+  uint64_t scene_rows[NUM_BUNKERS][BUNKER_HEIGHT]; ///< Bunker masks scene was composited from
+  bool scene_bunker[NUM_BUNKERS];          ///< Bunkers scene was composited with
+  ALLEGRO_THREAD *render_thread;           ///< Thread drawing the published frames, or NULL
+  ALLEGRO_MUTEX *render_mutex;             ///< Lets the render thread sleep on render_cond
+  ALLEGRO_COND *render_cond;               ///< Signalled when a frame is published
+  atomic_bool render_failed;               ///< Set by the render thread when drawing fails
+  ALLEGRO_FONT *font;                      ///< Font used in the game
+  TEXT_CACHE *texts;                       ///< Rendered lines of the HUD and overlays
+  ALLEGRO_SAMPLE *samples[10];             ///< Sound samples for the game
+  bool audio;                              ///< Whether samples are played (off when headless)
+  bool persist;                            ///< Whether scores are saved to disk (off when headless)
+
+  ALLEGRO_TIMER *timer;                    ///< Main game timer
+  ALLEGRO_EVENT_QUEUE *event_queue;        ///< Event queue for managing game events
+  ALLEGRO_EVENT events;                    ///< Structure to store current event
+  float FPS;                               ///< Frames per second for the game
+} GAME_MEDIA;
+
+/**
+ * @brief High-score table and initials entry screen.
+ */
+typedef struct {
   int high_score;                          ///< All-time high score (persisted to file)
-  bool paused;                             ///< Pause state
-  bool p_was_down;                         ///< Previous P-key state for edge-detection
-  bool ship_exploding;                     ///< Flag for ship death animation
-  int ship_explosion_timer;                ///< Timer for death animation
-  GAME_STATE state;                        ///< Current game state
   bool highscore_entry_active;             ///< True when entering initials for a new high score
   int highscore_entry_pos;                 ///< Current letter position (0-2) being edited
   int highscore_entry_cursor_timer;        ///< Timer for blinking cursor
-  char highscore_letters[3];  ///< Current letters being entered
+  char highscore_letters[3];               ///< Current letters being entered
   int highscore_score;                     ///< Score that needs a name entry
-
-  bool extra_life_1500_awarded;            ///< Extra life at 1500 points awarded
-  int title_timer;                         ///< Timer for title screen animation
   int highscore_entry_delay;               ///< Input delay when entering highscore screen
-  bool highscore_enter_needs_release;       ///< Require Enter release before accepting it
-  int level_start_delay;                    ///< Delay before enemies shoot at level start
+  bool highscore_enter_needs_release;      ///< Require Enter release before accepting it
 
   TOP_ENTRY top_scores[MAX_TOP_SCORES + 1]; ///< Top 5 high scores
+} GAME_UI;
+
+/**
+ * @brief Everything the renderer reads about one frame.
+ *
+ * The game fills one at the end of each drawn tick and publishes it
+ * through a triple buffer. Once published it is only read by the
+ * renderer, which may be on another thread while the next ticks run.
+ */
+typedef struct {
+  DRAW_LIST *draw_list;                    ///< Sprites of the frame, in drawing order
+  BUNKER bunkers[NUM_BUNKERS];             ///< Copy of each bunker
+  bool has_bunker[NUM_BUNKERS];            ///< Whether bunkers[i] exists
+  GAME_STATE state;                        ///< Screen to draw
+  bool paused;                             ///< Pause overlay shown
+  int title_timer;                         ///< Title screen animation
+  int total_score;                         ///< Player's score
+  int high_score;                          ///< All-time high score
+  int level;                               ///< Current wave
+  int highscore_entry_pos;                 ///< Letter being edited on the initials screen
+  int highscore_entry_cursor_timer;        ///< Blink of the initials cursor
+  char highscore_letters[3];               ///< Initials being entered
+  TOP_ENTRY top_scores[MAX_TOP_SCORES];    ///< Table shown on the title screen
+} RENDER_SNAPSHOT;
+
+/**
+ * @struct _game
+ * @brief Main game structure containing all game components and state
+ * variables.
+ *
+ * The per-tick simulation state comes first, followed by the entities it
+ * drives. Presentation resources and the high-score UI are kept apart at
+ * the end so they do not share cache lines with the simulation.
+ */
+struct _game {
+  GAME_SIM sim;                            ///< Per-tick simulation state
+
+  SHIP *ship;                              ///< Player ship instance
+  FORMATION *formation;                    ///< Martian formation (positions and alive grid)
+  SLOTMAP *bullets;                        ///< Every bullet in flight (packed, with stable handles)
+  SLOTMAP *objects;                        ///< Other objects in the game (packed, with stable handles)
+  OBJECT *ufo;                             ///< Mystery ship (UFO)
+  BUNKER *bunkers[NUM_BUNKERS];            ///< Destructible bunkers
+  GRID *grid;                              ///< Collision broadphase, rebuilt every tick
+  DRAW_LIST *draw_list;                    ///< Sprites of the tick, recorded into the back frame
+  HIT_EVENT hits[MAX_BULLETS];             ///< Hits of the current tick (at most one per bullet)
+  int num_hits;                            ///< Number of entries in hits
+  BULLET_SCHEDULE schedule;                ///< Bullets by the next tick they must be tested
+  BULLET_DUE schedule_items[BULLET_SCHEDULE_SIZE]; ///< Storage of schedule
+
+  GAME_MEDIA media;                        ///< Display, resources and events
+  GAME_UI ui;                              ///< High-score table and entry screen
+
+  RENDER_SNAPSHOT frames[TRIPLEBUF_SLOTS]; ///< Frames handed over to the renderer
+  TRIPLE_BUFFER frame_slots;               ///< Which frame the game and the renderer own
 };
 
 #if UFO_EMBEDDED
@@ -136,33 +332,41 @@ static ALLEGRO_BITMAP *game_create_ufo_bitmap(void) {
 
 // Function Declarations
 
-STATUS game_ship_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key);  /**< Updates ship input, shooting and bullets */
+STATUS game_ship_update(GAME *game, const GAME_INPUT *input);  /**< Updates ship input and shooting */
+STATUS game_ship_shoot(GAME *game);                               /**< Fires a player bullet if allowed */
 STATUS game_martian_shoot(GAME *game, int i);                     /**< Handles martian shooting */
-STATUS game_move_martians(GAME *game, float speed);               /**< Moves martians */
+STATUS game_move_martians(GAME *game, FIXED speed);               /**< Moves martians */
 STATUS game_destroy_martian(GAME *game, int i);                   /**< Destroys specified martian */
 STATUS game_colisions(GAME *game);                                /**< Checks for collisions */
 
-STATUS game_martians_update(GAME *game, float speed);             /**< Updates all martians */
+STATUS game_martians_update(GAME *game, FIXED speed);             /**< Updates all martians */
 STATUS game_animations_update(GAME *game);                        /**< Updates animations */
 
-STATUS game_add_orphan_bullet(GAME *game, BULLET *bullet);        /**< Adds an orphan bullet */
-BULLET *game_dequeue_orphan_bullet(GAME *game);                   /**< Dequeues an orphan bullet */
-BULLET *game_extract_orphan_bullet_at(GAME *game, int i);         /**< Extracts a specific orphan bullet */
-BULLET *game_get_orphan_bullet_at(GAME *game, int i);             /**< Gets a specific orphan bullet */
-STATUS game_move_orphan_bullets(GAME *game, float speed);         /**< Moves orphan bullets */
+STATUS game_add_bullet(GAME *game, BULLET *bullet);               /**< Adds a bullet to the game */
+BULLET *game_extract_bullet_at(GAME *game, int i);                /**< Extracts a specific bullet */
+STATUS game_kill_bullet_at(GAME *game, int i);                    /**< Destroys a bullet, leaving an empty slot */
+STATUS game_compact_bullets(GAME *game);                          /**< Removes empty bullet slots */
+BULLET *game_get_bullet_at(GAME *game, int i);                    /**< Gets a specific bullet */
+SLOT_HANDLE game_get_bullet_handle_at(GAME *game, int i);         /**< Gets a stable handle to a bullet */
+BULLET *game_get_bullet(GAME *game, SLOT_HANDLE handle);          /**< Gets a bullet from its handle */
+STATUS game_clear_bullets(GAME *game, BULLET_OWNER owner);        /**< Destroys every bullet of an owner */
+STATUS game_move_bullets(GAME *game);                             /**< Moves all bullets */
 
 STATUS game_add_object(GAME *game, OBJECT *object);               /**< Adds an object to the game */
 OBJECT *game_dequeue_object(GAME *game);                          /**< Removes an object from the game */
 OBJECT *game_extract_object_at(GAME *game, int i);                /**< Extracts a specific object */
 OBJECT *game_get_object_at(GAME *game, int i);                    /**< Gets a specific object */
+SLOT_HANDLE game_get_object_handle_at(GAME *game, int i);         /**< Gets a stable handle to an object */
+OBJECT *game_get_object(GAME *game, SLOT_HANDLE handle);          /**< Gets an object from its handle */
 
-STATUS game_print_ship(GAME *game);                               /**< Renders the player's ship */
-STATUS game_print_enemies(GAME *game);                            /**< Renders all enemies */
-STATUS game_print_orphan_bullets(GAME *game);                     /**< Renders orphan bullets */
-STATUS game_print_other_elements(GAME *game);                     /**< Renders other game elements */
-STATUS game_print_score(GAME *game);                              /**< Renders the score */
-STATUS game_print_life(GAME *game);                               /**< Renders the player's lives */
+static STATUS game_prepare_frame(GAME *game);                     /**< Records the sprites of the frame */
+static void game_publish_frame(GAME *game);                       /**< Hands the recorded frame to the renderer */
+STATUS game_print_score(GAME *game, const RENDER_SNAPSHOT *frame); /**< Renders the score */
 STATUS game_print_floor(GAME *game);                              /**< Renders the floor */
+static void game_compose_scene(GAME *game, RENDER_SNAPSHOT *frame, DIRTY_MAP *dirty); /**< Redraws the cached static layers if stale */
+static STATUS game_draw_frame(GAME *game, RENDER_SNAPSHOT *frame, const DIRTY_RECT *area); /**< Draws the frame, or part of it */
+static STATUS game_render_dirty(GAME *game, RENDER_SNAPSHOT *frame); /**< Redraws only what changed */
+static STATUS game_draw_snapshot(GAME *game, RENDER_SNAPSHOT *frame); /**< Draws and presents a frame */
 
 static STATUS game_load_highscore(GAME *game);                    /**< Loads high score from file */
 static STATUS game_save_highscore(GAME *game);                    /**< Saves high score to file if new record */
@@ -170,13 +374,90 @@ static STATUS game_load_top_scores(GAME *game);                   /**< Loads top
 static STATUS game_save_top_scores(GAME *game);                   /**< Saves top scores to file */
 static void game_insert_top_score(GAME *game, int score);         /**< Inserts score into sorted top list */
 static STATUS game_reset_enemies(GAME *game);                     /**< Destroys + recreates full enemy grid */
-static STATUS game_reset_bunkers(GAME *game);                     /**< Destroys + recreates all bunker parts */
+static STATUS game_reset_bunkers(GAME *game);                     /**< Destroys + recreates all bunkers */
 static STATUS game_reset_ship(GAME *game);                        /**< Resets ship position, lives, bullets */
 static STATUS game_next_level(GAME *game);                        /**< Advances to next wave */
 static STATUS game_full_reset(GAME *game);                        /**< Full game restart (score + level reset) */
 
 // Game Management Functions
 
+/**
+ * @brief Allocates a GAME on a cache line boundary.
+ *
+ * malloc() only guarantees 16-byte alignment, which is not enough for the
+ * aligned simulation block at the start of the structure.
+ */
+static GAME *game_alloc(void) {
+#ifdef _WIN32
+  return (GAME *)_aligned_malloc(sizeof(GAME), _Alignof(GAME));
+#else
+  return (GAME *)aligned_alloc(_Alignof(GAME), sizeof(GAME));
+#endif
+}
+
+/**
+ * @brief Frees a GAME allocated with game_alloc().
+ */
+static void game_free(GAME *game) {
+#ifdef _WIN32
+  _aligned_free(game);
+#else
+  free(game);
+#endif
+}
+
+/**
+ * @brief Advances a random generator state and returns its next value.
+ *
+ * The linear congruential generator of the C standard example, so values
+ * are in [0, 32767]. Its state is a plain integer, which lets the game
+ * keep its own sequence and replay it on a copy.
+ *
+ * @param state Generator state to advance.
+ * @return Next value of the sequence.
+ */
+static int game_rand_next(uint32_t *state) {
+  *state = *state * 1103515245u + 12345u;
+  return (int)((*state >> 16) & 0x7FFF);
+}
+
+/**
+ * @brief Next value of the game's random sequence.
+ *
+ * Gameplay draws from the game's own generator instead of rand(), so a
+ * run depends only on its seed and inputs.
+ */
+static int game_rand(GAME *game) {
+  return game_rand_next(&game->sim.rng);
+}
+
+/**
+ * @brief Plays one of the game samples once, or in a loop.
+ *
+ * Does nothing while audio is disabled.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param sample Index in game->media.samples.
+ * @param speed Playback speed (1.0 is normal).
+ * @param mode ALLEGRO_PLAYMODE_ONCE or ALLEGRO_PLAYMODE_LOOP.
+ */
+static void game_play_sample(GAME *game, int sample, float speed, ALLEGRO_PLAYMODE mode) {
+  if (game->media.audio) {
+    al_play_sample(game->media.samples[sample], 1.0, 0.0, speed, mode, NULL);
+  }
+}
+
+/**
+ * @brief Stops every playing sample. Does nothing while audio is disabled.
+ *
+ * @param game Pointer to the GAME instance.
+ */
+static void game_stop_samples(GAME *game) {
+  if (game->media.audio) {
+    al_stop_samples();
+  }
+}
+
 /**
  * @brief Creates and initializes a new game instance.
  *
@@ -188,89 +469,128 @@ static STATUS game_full_reset(GAME *game);                        /**< Full game
 GAME *game_create() {
   GAME *new_game = NULL;
 
-  new_game = (GAME *)malloc(sizeof(GAME));
+  new_game = game_alloc();
   if (!new_game) {
     return NULL;
   }
 
-  new_game->screen = NULL;
-  new_game->background = NULL;
-  new_game->frame = NULL;
-  new_game->ship_img = NULL;
-  new_game->ship_bullet_img = NULL;
-  new_game->martian_img = NULL;
-  new_game->martian_bullet_img = NULL;
-  new_game->martian_explosion_img = NULL;
-  new_game->bunker_img = NULL;
-  new_game->ufo_img = NULL;
-  new_game->font = NULL;
+  new_game->media.screen = NULL;
+  new_game->media.background = NULL;
+  new_game->media.frame = NULL;
+  new_game->media.ship_img = NULL;
+  new_game->media.ship_bullet_img = NULL;
+  new_game->media.martian_img = NULL;
+  new_game->media.martian_bullet_img = NULL;
+  new_game->media.martian_explosion_img = NULL;
+  new_game->media.bunker_img = NULL;
+  new_game->media.ufo_img = NULL;
+  new_game->media.atlas = NULL;
+  new_game->media.bunker_image = NULL;
+  new_game->media.scene = NULL;
+  new_game->media.scene_valid = false;
+  new_game->media.scene_floor = false;
+  new_game->media.dirty_rects = false;
+  new_game->media.canvas = NULL;
+  new_game->media.canvas_valid = false;
+  new_game->media.dirty = NULL;
+  new_game->media.sprites = NULL;
+  new_game->media.prev_sprites = NULL;
+  new_game->media.hud_score = -1;
+  new_game->media.hud_high_score = -1;
+  new_game->media.hud_level = -1;
+  new_game->media.font = NULL;
+  new_game->media.texts = NULL;
+  new_game->media.render_thread = NULL;
+  new_game->media.render_mutex = NULL;
+  new_game->media.render_cond = NULL;
+  atomic_init(&new_game->media.render_failed, false);
+  for (int i = 0; i < NUM_BUNKERS; i++) {
+    new_game->media.scene_bunker[i] = false;
+  }
 
-  new_game->timer = NULL;
-  new_game->event_queue = NULL;
+  new_game->media.timer = NULL;
+  new_game->media.event_queue = NULL;
 
   new_game->ship = NULL;
-
-  for (int i = 0; i < MAX_ENEMIES; i++) {
-    new_game->enemy[i] = NULL;
+  new_game->formation = NULL;
+
+  new_game->bullets = slotmap_create(MAX_BULLETS);
+  new_game->objects = slotmap_create(MAX_OBJECTS);
+  new_game->grid = grid_create(DISPLAY_WIDTH, DISPLAY_HEIGHT, GRID_CELL_SIZE, GRID_MAX_ID,
+                               GRID_MAX_NODES);
+  bool frames_ok = true;
+  for (int i = 0; i < TRIPLEBUF_SLOTS; i++) {
+    new_game->frames[i].draw_list = drawlist_create(DRAW_LIST_SIZE);
+    frames_ok = frames_ok && new_game->frames[i].draw_list;
   }
-
-  for (int i = 0; i < MAX_ORP_BULLETS; i++) {
-    new_game->orphan_bullets[i] = NULL;
+  if (!new_game->bullets || !new_game->objects || !new_game->grid || !frames_ok) {
+    slotmap_destroy(new_game->bullets);
+    slotmap_destroy(new_game->objects);
+    grid_destroy(new_game->grid);
+    for (int i = 0; i < TRIPLEBUF_SLOTS; i++) {
+      drawlist_destroy(new_game->frames[i].draw_list);
+    }
+    game_free(new_game);
+    return NULL;
   }
 
-  for (int i = 0; i < MAX_OBJECTS; i++) {
-    new_game->objects[i] = NULL;
-  }
+  // The game records into the back frame
+  triplebuf_init(&new_game->frame_slots);
+  new_game->draw_list = new_game->frames[triplebuf_back(&new_game->frame_slots)].draw_list;
 
-  for (int i = 0; i < NUM_BUNKERS * BUNKER_PARTS; i++) {
+  for (int i = 0; i < NUM_BUNKERS; i++) {
     new_game->bunkers[i] = NULL;
   }
 
-  new_game->FPS = 0.0;
-  new_game->draw = false;
-  new_game->done = false;
-
-  new_game->num_enemies_destroyed = 0;
-  new_game->num_enemies_alive = 0;
-  new_game->last_enemy_rand = 0;
-
-  new_game->enemy_shoot_timer = 0;
-  new_game->enemy_animation_timer = 0;
-  new_game->enemy_move_timer = 0;
-  new_game->enemies_dir = RIGHT;
-
-  new_game->num_orphan_bullets = 0;
-  new_game->num_objects = 0;
-  new_game->total_score = 0;
-  new_game->level = 1;
-  new_game->level_y_offset = 0;
-  new_game->high_score = 0;
-  new_game->paused = false;
-  new_game->p_was_down = false;
+  new_game->media.FPS = 0.0;
+  new_game->media.audio = true;
+  new_game->media.persist = true;
+  new_game->num_hits = 0;
+  bullet_schedule_init(&new_game->schedule, new_game->schedule_items, BULLET_SCHEDULE_SIZE);
+  new_game->sim.draw = false;
+  new_game->sim.done = false;
+
+  new_game->sim.num_enemies_destroyed = 0;
+  new_game->sim.num_enemies_alive = 0;
+  new_game->sim.last_enemy_rand = 0;
+
+  new_game->sim.enemy_shoot_timer = 0;
+  new_game->sim.enemy_animation_timer = 0;
+  new_game->sim.enemy_move_timer = 0;
+
+  new_game->sim.num_ship_bullets = 0;
+  new_game->sim.bullet_tick = 0;
+  new_game->sim.total_score = 0;
+  new_game->sim.rng = 1;
+  new_game->sim.level = 1;
+  new_game->sim.level_y_offset = 0;
+  new_game->ui.high_score = 0;
+  new_game->sim.paused = false;
+  new_game->sim.p_was_down = false;
 
   new_game->ufo = NULL;
-  new_game->ufo_timer = 0;
+  new_game->sim.ufo_timer = 0;
 
   for (int i = 0; i < 10; i++) {
-    new_game->samples[i] = NULL;
+    new_game->media.samples[i] = NULL;
   }
 
   for (int i = 0; i <= MAX_TOP_SCORES; i++) {
-    strcpy(new_game->top_scores[i].name, "---");
-    new_game->top_scores[i].score = 0;
+    strcpy(new_game->ui.top_scores[i].name, "---");
+    new_game->ui.top_scores[i].score = 0;
   }
 
-  new_game->highscore_entry_active = false;
-  new_game->highscore_entry_pos = 0;
-  new_game->highscore_entry_cursor_timer = 0;
-  memset(new_game->highscore_letters, 0, sizeof(new_game->highscore_letters));
-  new_game->highscore_score = 0;
+  new_game->ui.highscore_entry_active = false;
+  new_game->ui.highscore_entry_pos = 0;
+  new_game->ui.highscore_entry_cursor_timer = 0;
+  memset(new_game->ui.highscore_letters, 0, sizeof(new_game->ui.highscore_letters));
+  new_game->ui.highscore_score = 0;
 
-  new_game->extra_life_1500_awarded = false;
-  new_game->title_timer = 0;
-  new_game->highscore_entry_delay = 0;
-  new_game->highscore_enter_needs_release = false;
-  new_game->level_start_delay = 0;
+  new_game->sim.extra_life_1500_awarded = false;
+  new_game->sim.title_timer = 0;
+  new_game->ui.highscore_entry_delay = 0;
+  new_game->ui.highscore_enter_needs_release = false;
+  new_game->sim.level_start_delay = 0;
 
   return new_game;
 }
@@ -289,27 +609,41 @@ STATUS game_destroy(GAME *game) {
     return ERROR;
   }
 
+  // The render thread reads the frames and the render resources
+  game_stop_render_thread(game);
+
   if (game->ufo) {
     obj_destroy(game->ufo);
     game->ufo = NULL;
   }
 
-  for (int i = 0; i < game->num_objects; i++) {
-    obj_destroy(game->objects[i]);
-    game->objects[i] = NULL;
+  for (int i = 0; i < slotmap_size(game->objects); i++) {
+    obj_destroy(slotmap_get_at(game->objects, i));
   }
+  slotmap_destroy(game->objects);
+  game->objects = NULL;
 
-  for (int i = 0; i < game->num_orphan_bullets; i++) {
-    bullet_destroy(game->orphan_bullets[i]);
-    game->orphan_bullets[i] = NULL;
+  for (int i = 0; i < slotmap_size(game->bullets); i++) {
+    bullet_destroy(slotmap_get_at(game->bullets, i));
   }
+  slotmap_destroy(game->bullets);
+  game->bullets = NULL;
 
-  for (int i = 0; i < game->num_enemies_alive; i++) {
-    mart_destroy(game->enemy[i]);
-    game->enemy[i] = NULL;
+  grid_destroy(game->grid);
+  game->grid = NULL;
+
+  for (int i = 0; i < TRIPLEBUF_SLOTS; i++) {
+    drawlist_destroy(game->frames[i].draw_list);
+    game->frames[i].draw_list = NULL;
+  }
+  game->draw_list = NULL;
+
+  if (game->formation) {
+    form_destroy(game->formation);
+    game->formation = NULL;
   }
 
-  for (int i = 0; i < NUM_BUNKERS * BUNKER_PARTS; i++) {
+  for (int i = 0; i < NUM_BUNKERS; i++) {
     if (game->bunkers[i] != NULL) {
       bunker_destroy(game->bunkers[i]);
       game->bunkers[i] = NULL;
@@ -321,78 +655,112 @@ STATUS game_destroy(GAME *game) {
     game->ship = NULL;
   }
 
-  if (game->event_queue) {
-    al_destroy_event_queue(game->event_queue);
-    game->event_queue = NULL;
+  if (game->media.event_queue) {
+    al_destroy_event_queue(game->media.event_queue);
+    game->media.event_queue = NULL;
+  }
+
+  // Text bitmaps first: they are rendered with the font
+  if (game->media.texts) {
+    textcache_destroy(game->media.texts);
+    game->media.texts = NULL;
+  }
+
+  if (game->media.font) {
+    al_destroy_font(game->media.font);
+  }
+
+  if (game->media.martian_explosion_img) {
+    al_destroy_bitmap(game->media.martian_explosion_img);
+    game->media.martian_explosion_img = NULL;
+  }
+
+  if (game->media.martian_bullet_img) {
+    al_destroy_bitmap(game->media.martian_bullet_img);
+    game->media.martian_bullet_img = NULL;
   }
 
-  if (game->font) {
-    al_destroy_font(game->font);
+  if (game->media.martian_img) {
+    al_destroy_bitmap(game->media.martian_img);
+    game->media.martian_img = NULL;
   }
 
-  if (game->martian_explosion_img) {
-    al_destroy_bitmap(game->martian_explosion_img);
-    game->martian_explosion_img = NULL;
+  if (game->media.ship_bullet_img) {
+    al_destroy_bitmap(game->media.ship_bullet_img);
+    game->media.ship_bullet_img = NULL;
   }
 
-  if (game->martian_bullet_img) {
-    al_destroy_bitmap(game->martian_bullet_img);
-    game->martian_bullet_img = NULL;
+  if (game->media.ship_img) {
+    al_destroy_bitmap(game->media.ship_img);
+    game->media.ship_img = NULL;
   }
 
-  if (game->martian_img) {
-    al_destroy_bitmap(game->martian_img);
-    game->martian_img = NULL;
+  if (game->media.frame) {
+    al_destroy_bitmap(game->media.frame);
+    game->media.frame = NULL;
   }
 
-  if (game->ship_bullet_img) {
-    al_destroy_bitmap(game->ship_bullet_img);
-    game->ship_bullet_img = NULL;
+  if (game->media.background) {
+    al_destroy_bitmap(game->media.background);
+    game->media.background = NULL;
   }
 
-  if (game->ship_img) {
-    al_destroy_bitmap(game->ship_img);
-    game->ship_img = NULL;
+  if (game->media.scene) {
+    al_destroy_bitmap(game->media.scene);
+    game->media.scene = NULL;
   }
 
-  if (game->frame) {
-    al_destroy_bitmap(game->frame);
-    game->frame = NULL;
+  if (game->media.canvas) {
+    al_destroy_bitmap(game->media.canvas);
+    game->media.canvas = NULL;
   }
 
-  if (game->background) {
-    al_destroy_bitmap(game->background);
-    game->background = NULL;
+  dirtymap_destroy(game->media.dirty);
+  dirtymap_destroy(game->media.sprites);
+  dirtymap_destroy(game->media.prev_sprites);
+  game->media.dirty = NULL;
+  game->media.sprites = NULL;
+  game->media.prev_sprites = NULL;
+
+  if (game->media.bunker_img) {
+    al_destroy_bitmap(game->media.bunker_img);
+    game->media.bunker_img = NULL;
+  }
+
+  if (game->media.ufo_img) {
+    al_destroy_bitmap(game->media.ufo_img);
+    game->media.ufo_img = NULL;
   }
 
-  if (game->bunker_img) {
-    al_destroy_bitmap(game->bunker_img);
-    game->bunker_img = NULL;
+  // The sprite images are regions of the atlas, so it goes last
+  if (game->media.bunker_image) {
+    al_destroy_bitmap(game->media.bunker_image);
+    game->media.bunker_image = NULL;
   }
 
-  if (game->ufo_img) {
-    al_destroy_bitmap(game->ufo_img);
-    game->ufo_img = NULL;
+  if (game->media.atlas) {
+    atlas_destroy(game->media.atlas);
+    game->media.atlas = NULL;
   }
 
-  if (game->screen) {
-    al_destroy_display(game->screen);
-    game->screen = NULL;
+  if (game->media.screen) {
+    al_destroy_display(game->media.screen);
+    game->media.screen = NULL;
   }
 
   for (int i = 0; i < 10; i++) {
-    if (game->samples[i]) {
-      al_destroy_sample(game->samples[i]);
-      game->samples[i] = NULL;
+    if (game->media.samples[i]) {
+      al_destroy_sample(game->media.samples[i]);
+      game->media.samples[i] = NULL;
     }
   }
 
-  if (game->timer) {
-    al_destroy_timer(game->timer);
-    game->timer = NULL;
+  if (game->media.timer) {
+    al_destroy_timer(game->media.timer);
+    game->media.timer = NULL;
   }
 
-  free(game);
+  game_free(game);
 
   return OK;
 }
@@ -407,7 +775,7 @@ static STATUS game_load_top_scores(GAME *game) {
   if (!f) return OK;
 
   for (int i = 0; i <= MAX_TOP_SCORES; i++) {
-    if (fscanf(f, "%3s %d", game->top_scores[i].name, &game->top_scores[i].score) != 2)
+    if (fscanf(f, "%3s %d", game->ui.top_scores[i].name, &game->ui.top_scores[i].score) != 2)
       break;
   }
 
@@ -420,12 +788,13 @@ static STATUS game_load_top_scores(GAME *game) {
  */
 static STATUS game_save_top_scores(GAME *game) {
   if (!game) return ERROR;
+  if (!game->media.persist) return OK;
 
   FILE *f = fopen(TOP_SCORES_FILE, "w");
   if (!f) return ERROR;
 
   for (int i = 0; i <= MAX_TOP_SCORES; i++) {
-    fprintf(f, "%s %d\n", game->top_scores[i].name, game->top_scores[i].score);
+    fprintf(f, "%s %d\n", game->ui.top_scores[i].name, game->ui.top_scores[i].score);
   }
 
   fclose(f);
@@ -439,12 +808,12 @@ static void game_insert_top_score(GAME *game, int score) {
   if (!game || score <= 0) return;
 
   for (int i = 0; i <= MAX_TOP_SCORES; i++) {
-    if (score > game->top_scores[i].score) {
+    if (score > game->ui.top_scores[i].score) {
       for (int j = MAX_TOP_SCORES; j > i; j--) {
-        game->top_scores[j] = game->top_scores[j - 1];
+        game->ui.top_scores[j] = game->ui.top_scores[j - 1];
       }
-      strcpy(game->top_scores[i].name, "---");
-      game->top_scores[i].score = score;
+      strcpy(game->ui.top_scores[i].name, "---");
+      game->ui.top_scores[i].score = score;
       break;
     }
   }
@@ -457,7 +826,7 @@ static int game_highscore_verify(GAME *game, int score) {
   if (!game || score <= 0) return 0;
 
   for (int i = 0; i <= MAX_TOP_SCORES; i++) {
-    if (score > game->top_scores[i].score) {
+    if (score > game->ui.top_scores[i].score) {
       return 1;
     }
   }
@@ -475,7 +844,7 @@ static STATUS game_load_highscore(GAME *game) {
 
   FILE *f = fopen(HIGHSCORE_FILE, "r");
   if (f) {
-    fscanf(f, "%d", &game->high_score);
+    fscanf(f, "%d", &game->ui.high_score);
     fclose(f);
   }
 
@@ -491,11 +860,11 @@ static STATUS game_load_highscore(GAME *game) {
 static STATUS game_save_highscore(GAME *game) {
   if (!game) return ERROR;
 
-  if (game->total_score > game->high_score) {
-    game->high_score = game->total_score;
-    FILE *f = fopen(HIGHSCORE_FILE, "w");
+  if (game->sim.total_score > game->ui.high_score) {
+    game->ui.high_score = game->sim.total_score;
+    FILE *f = game->media.persist ? fopen(HIGHSCORE_FILE, "w") : NULL;
     if (f) {
-      fprintf(f, "%d", game->high_score);
+      fprintf(f, "%d", game->ui.high_score);
       fclose(f);
     }
   }
@@ -504,7 +873,7 @@ static STATUS game_save_highscore(GAME *game) {
 }
 
 /**
- * @brief Destroys all current enemies, orphan bullets, and objects, then
+ * @brief Destroys all current enemies, martian bullets, and objects, then
  * recreates the full 11x5 martian formation.
  *
  * @param game Pointer to the GAME instance.
@@ -513,63 +882,31 @@ static STATUS game_save_highscore(GAME *game) {
 static STATUS game_reset_enemies(GAME *game) {
   if (!game) return ERROR;
 
-  for (int i = 0; i < game->num_enemies_alive; i++) {
-    if (game->enemy[i] != NULL) {
-      mart_destroy(game->enemy[i]);
-      game->enemy[i] = NULL;
-    }
-  }
-
-  for (int i = game->num_orphan_bullets - 1; i >= 0; i--) {
-    bullet_destroy(game_extract_orphan_bullet_at(game, i));
-  }
+  game_clear_bullets(game, BULLET_MARTIAN);
 
-  for (int i = game->num_objects - 1; i >= 0; i--) {
+  for (int i = slotmap_size(game->objects) - 1; i >= 0; i--) {
     obj_destroy(game_extract_object_at(game, i));
   }
 
-  game->enemies_dir = RIGHT;
-  game->enemy_shoot_timer = 0;
-  game->enemy_move_timer = 0;
-  game->enemy_animation_timer = 0;
+  game->sim.enemy_shoot_timer = 0;
+  game->sim.enemy_move_timer = 0;
+  game->sim.enemy_animation_timer = 0;
 
-  for (int y = 0, i = 0; y < NUM_ENEMY_Y; y++) {
-    int source_y, score;
-
-    if (i <= 10) {
-      source_y = 0;
-      score = POINTS_01;
-    } else if (i > 10 && i <= 31) {
-      source_y = 1;
-      score = POINTS_02;
-    } else {
-      source_y = 2;
-      score = POINTS_03;
-    }
-
-    for (int x = 0; x < NUM_ENEMY_X; x++) {
-      game->enemy[i] = mart_create(game->martian_img, MART_WIDTH, MART_HEIGHT,
-                                   MART_INIT_POS_X + x * SPACE_BTW_MARTIANS_X,
-                                   MART_INIT_POS_Y + game->level_y_offset + y * SPACE_BTW_MARTIANS_Y,
-                                   &(game->enemies_dir), score);
-      if (!game->enemy[i]) {
-        return ERROR;
-      }
-      mart_set_source_y(game->enemy[i], source_y);
-      i++;
-    }
+  if (form_reset(game->formation, INT_TO_FIXED(MART_INIT_POS_X),
+                 INT_TO_FIXED(MART_INIT_POS_Y + game->sim.level_y_offset)) == ERROR) {
+    return ERROR;
   }
 
-  game->num_enemies_alive = MAX_ENEMIES;
-  game->num_enemies_destroyed = 0;
-  game->last_enemy_rand = 0;
+  game->sim.num_enemies_alive = form_get_size(game->formation);
+  game->sim.num_enemies_destroyed = 0;
+  game->sim.last_enemy_rand = 0;
 
   return OK;
 }
 
 /**
- * @brief Destroys all bunker parts and recreates them in their original
- * positions.
+ * @brief Destroys all bunkers and recreates them undamaged in their
+ * original positions.
  *
  * @param game Pointer to the GAME instance.
  * @return OK if successful, ERROR on allocation failure.
@@ -577,33 +914,21 @@ static STATUS game_reset_enemies(GAME *game) {
 static STATUS game_reset_bunkers(GAME *game) {
   if (!game) return ERROR;
 
-  for (int i = 0; i < NUM_BUNKERS * BUNKER_PARTS; i++) {
+  for (int i = 0; i < NUM_BUNKERS; i++) {
     if (game->bunkers[i] != NULL) {
       bunker_destroy(game->bunkers[i]);
       game->bunkers[i] = NULL;
     }
   }
 
-  float bunker_spacing = (DISPLAY_WIDTH - 120) / NUM_BUNKERS;
+  int bunker_spacing = (DISPLAY_WIDTH - 120) / NUM_BUNKERS;
   for (int i = 0; i < NUM_BUNKERS; i++) {
-    float bx = 60 + i * bunker_spacing;
-    float by = BUNKER_INIT_POS_Y;
-
-    game->bunkers[i * BUNKER_PARTS + 0] =
-        bunker_create(game->bunker_img, 0, 0, BUNKER_PART_WIDTH, BUNKER_PART_HEIGHT, bx, by);
-    game->bunkers[i * BUNKER_PARTS + 1] =
-        bunker_create(game->bunker_img, 0, 4, BUNKER_PART_WIDTH, BUNKER_PART_HEIGHT, bx + BUNKER_PART_WIDTH, by);
-    game->bunkers[i * BUNKER_PARTS + 2] =
-        bunker_create(game->bunker_img, 0, 2, BUNKER_PART_WIDTH, BUNKER_PART_HEIGHT, bx + BUNKER_PART_WIDTH * 2, by);
-    game->bunkers[i * BUNKER_PARTS + 3] =
-        bunker_create(game->bunker_img, 0, 1, BUNKER_PART_WIDTH, BUNKER_PART_HEIGHT, bx, by + BUNKER_PART_HEIGHT);
-    game->bunkers[i * BUNKER_PARTS + 4] =
-        bunker_create(game->bunker_img, 0, 3, BUNKER_PART_WIDTH, BUNKER_PART_HEIGHT, bx + BUNKER_PART_WIDTH * 2, by + BUNKER_PART_HEIGHT);
-
-    for (int j = 0; j < BUNKER_PARTS; j++) {
-      if (!game->bunkers[i * BUNKER_PARTS + j]) {
-        return ERROR;
-      }
+    FIXED bx = INT_TO_FIXED(60 + i * bunker_spacing);
+    FIXED by = INT_TO_FIXED(BUNKER_INIT_POS_Y);
+
+    game->bunkers[i] = bunker_create(SPRITE_BUNKER, SPRITE_BUNKER_IMAGE, i, bx, by);
+    if (!game->bunkers[i]) {
+      return ERROR;
     }
   }
 
@@ -620,16 +945,14 @@ static STATUS game_reset_bunkers(GAME *game) {
 static STATUS game_reset_ship(GAME *game) {
   if (!game || !game->ship) return ERROR;
 
-  for (int i = ship_get_num_shots(game->ship) - 1; i >= 0; i--) {
-    bullet_destroy(ship_extract_bullet_at(game->ship, i));
-  }
+  game_clear_bullets(game, BULLET_SHIP);
 
-  ship_set_x(game->ship, SHIP_INIT_POS_X);
-  ship_set_y(game->ship, SHIP_INIT_POS_Y);
+  ship_set_x(game->ship, INT_TO_FIXED(SHIP_INIT_POS_X));
+  ship_set_y(game->ship, INT_TO_FIXED(SHIP_INIT_POS_Y));
   ship_set_life(game->ship, SHIP_LIFE);
   ship_set_source_x(game->ship, 0);
-  game->ship_exploding = false;
-  game->ship_explosion_timer = 0;
+  game->sim.ship_exploding = false;
+  game->sim.ship_explosion_timer = 0;
 
   return OK;
 }
@@ -645,24 +968,24 @@ static STATUS game_next_level(GAME *game) {
   if (!game) return ERROR;
 
   if (game->ufo) {
-    al_stop_samples();
+    game_stop_samples(game);
     obj_destroy(game->ufo);
     game->ufo = NULL;
   }
 
-  game->level++;
+  game->sim.level++;
 
   // In the original arcade, enemies start one row lower each wave
-  game->level_y_offset = (game->level - 1) * SPACE_BTW_MARTIANS_Y;
-  if (game->level_y_offset > 6 * SPACE_BTW_MARTIANS_Y)
-    game->level_y_offset = 6 * SPACE_BTW_MARTIANS_Y;
+  game->sim.level_y_offset = (game->sim.level - 1) * SPACE_BTW_MARTIANS_Y;
+  if (game->sim.level_y_offset > 6 * SPACE_BTW_MARTIANS_Y)
+    game->sim.level_y_offset = 6 * SPACE_BTW_MARTIANS_Y;
 
   if (game_reset_enemies(game) == ERROR) {
     return ERROR;
   }
 
-  game->level_start_delay = 45;
-  game->state = STATE_PLAYING;
+  game->sim.level_start_delay = 45;
+  game->sim.state = STATE_PLAYING;
 
   return OK;
 }
@@ -678,17 +1001,17 @@ static STATUS game_full_reset(GAME *game) {
   if (!game) return ERROR;
 
   if (game->ufo) {
-    al_stop_samples();
+    game_stop_samples(game);
     obj_destroy(game->ufo);
     game->ufo = NULL;
   }
 
-  game->total_score = 0;
-  game->level = 1;
-  game->level_y_offset = 0;
-  game->paused = false;
-  game->extra_life_1500_awarded = false;
-  game->level_start_delay = 45;
+  game->sim.total_score = 0;
+  game->sim.level = 1;
+  game->sim.level_y_offset = 0;
+  game->sim.paused = false;
+  game->sim.extra_life_1500_awarded = false;
+  game->sim.level_start_delay = 45;
 
   if (game_reset_ship(game) == ERROR) {
     return ERROR;
@@ -702,7 +1025,7 @@ static STATUS game_full_reset(GAME *game) {
     return ERROR;
   }
 
-  game->state = STATE_PLAYING;
+  game->sim.state = STATE_PLAYING;
 
   return OK;
 }
@@ -712,124 +1035,209 @@ static STATUS game_full_reset(GAME *game) {
 // =========================================================================
 
 /**
- * @brief Initializes the game with provided FPS and sets up the display,
- * bitmaps, fonts, and other resources.
+ * @brief Moves a loaded sprite image into the texture atlas.
  *
- * This function loads images, initializes timers, creates the player ship,
- * and generates enemy instances.
+ * On success the image is destroyed and replaced by the atlas region
+ * holding its copy. On failure it is left as it was.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param bitmap Image to move, replaced in place.
+ * @return OK if the image was moved, ERROR if it does not fit in the atlas.
+ */
+static STATUS game_pack_sprite(GAME *game, ALLEGRO_BITMAP **bitmap) {
+  ALLEGRO_BITMAP *region = atlas_add(game->media.atlas, *bitmap);
+
+  if (!region) {
+    return ERROR;
+  }
+
+  al_destroy_bitmap(*bitmap);
+  *bitmap = region;
+
+  return OK;
+}
+
+/**
+ * @brief Sets up the display, bitmaps, fonts, sounds, timer and events.
+ *
+ * Loads the images, packs them into the atlas and registers the sprite
+ * descriptors the simulation and the renderer share.
  *
  * @param game Pointer to the GAME instance.
  * @param FPS Frames per second setting for the game.
  * @return OK if initialization succeeds, ERROR if any setup fails.
  */
-STATUS game_init(GAME *game, float FPS) {
-  if (!game) {
+static STATUS game_init_media(GAME *game, float FPS) {
+  game->media.FPS = FPS;
+  game->media.timer = al_create_timer(1.0 / game->media.FPS);
+
+  if (!game->media.timer) {
     return ERROR;
   }
 
-  game->FPS = FPS;
-  game->timer = al_create_timer(1.0 / game->FPS);
-
-  if (!game->timer) {
+  game->media.screen = al_create_display(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  if (!game->media.screen) {
     return ERROR;
   }
 
-  game->screen = al_create_display(DISPLAY_WIDTH, DISPLAY_HEIGHT);
-  if (!game->screen) {
+  game->media.background = al_load_bitmap(BACKGROUND_IMG_RSC);
+  if (!game->media.background) {
     return ERROR;
   }
 
-  game->background = al_load_bitmap(BACKGROUND_IMG_RSC);
-  if (!game->background) {
+  game->media.frame = al_load_bitmap(FRAME_IMG_RSC);
+  if (!game->media.frame) {
     return ERROR;
   }
+  al_convert_mask_to_alpha(game->media.frame, al_map_rgb(255, 0, 255));
 
-  game->frame = al_load_bitmap(FRAME_IMG_RSC);
-  if (!game->frame) {
+  game->media.scene = al_create_bitmap(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  if (!game->media.scene) {
     return ERROR;
   }
-  al_convert_mask_to_alpha(game->frame, al_map_rgb(255, 0, 255));
 
-  game->ship_img = al_load_bitmap(SHIP_IMG_RSC);
-  if (!game->ship_img) {
+  // Without video bitmaps every full-screen blit is done by the CPU
+  if (al_get_bitmap_flags(game->media.scene) & ALLEGRO_MEMORY_BITMAP) {
+    game_set_dirty_rects(game, true);
+  }
+
+  game->media.ship_img = al_load_bitmap(SHIP_IMG_RSC);
+  if (!game->media.ship_img) {
     return ERROR;
   }
-  al_convert_mask_to_alpha(game->ship_img, al_map_rgb(255, 0, 255));
+  al_convert_mask_to_alpha(game->media.ship_img, al_map_rgb(255, 0, 255));
 
-  game->ship_bullet_img = al_load_bitmap(SHIP_BULLET_IMG_RSC);
-  if (!game->ship_bullet_img) {
+  game->media.ship_bullet_img = al_load_bitmap(SHIP_BULLET_IMG_RSC);
+  if (!game->media.ship_bullet_img) {
     return ERROR;
   }
-  al_convert_mask_to_alpha(game->ship_bullet_img, al_map_rgb(255, 0, 255));
+  al_convert_mask_to_alpha(game->media.ship_bullet_img, al_map_rgb(255, 0, 255));
 
-  game->martian_img = al_load_bitmap(MARTIAN_IMG_RSC);
-  if (!game->martian_img) {
+  game->media.martian_img = al_load_bitmap(MARTIAN_IMG_RSC);
+  if (!game->media.martian_img) {
     return ERROR;
   }
-  al_convert_mask_to_alpha(game->martian_img, al_map_rgb(255, 0, 255));
+  al_convert_mask_to_alpha(game->media.martian_img, al_map_rgb(255, 0, 255));
 
-  game->martian_bullet_img = al_load_bitmap(MART_BULLET_IMG_RSC);
-  if (!game->martian_bullet_img) {
+  game->media.martian_bullet_img = al_load_bitmap(MART_BULLET_IMG_RSC);
+  if (!game->media.martian_bullet_img) {
     return ERROR;
   }
-  al_convert_mask_to_alpha(game->martian_bullet_img, al_map_rgb(255, 0, 255));
+  al_convert_mask_to_alpha(game->media.martian_bullet_img, al_map_rgb(255, 0, 255));
 
-  game->martian_explosion_img = al_load_bitmap(EXPLOSION_IMG_RSC);
-  if (!game->martian_explosion_img) {
+  game->media.martian_explosion_img = al_load_bitmap(EXPLOSION_IMG_RSC);
+  if (!game->media.martian_explosion_img) {
     return ERROR;
   }
-  al_convert_mask_to_alpha(game->martian_explosion_img, al_map_rgb(255, 0, 255));
+  al_convert_mask_to_alpha(game->media.martian_explosion_img, al_map_rgb(255, 0, 255));
 
-  game->bunker_img = al_load_bitmap(BUNKER_IMG_RSC);
-  if (!game->bunker_img) {
+  game->media.bunker_img = al_load_bitmap(BUNKER_IMG_RSC);
+  if (!game->media.bunker_img) {
     return ERROR;
   }
-  al_convert_mask_to_alpha(game->bunker_img, al_map_rgb(255, 0, 255));
+  al_convert_mask_to_alpha(game->media.bunker_img, al_map_rgb(255, 0, 255));
 
 #if UFO_EMBEDDED
-  game->ufo_img = game_create_ufo_bitmap();
+  game->media.ufo_img = game_create_ufo_bitmap();
 #else
-  game->ufo_img = al_load_bitmap(UFO_IMG_RSC);
+  game->media.ufo_img = al_load_bitmap(UFO_IMG_RSC);
 #endif
-  if (!game->ufo_img) {
+  if (!game->media.ufo_img) {
+    return ERROR;
+  }
+
+  // Copy every sprite into one texture, so a sprite pass is a single batch
+  game->media.atlas = atlas_create(ATLAS_SIZE, ATLAS_SIZE);
+  if (!game->media.atlas) {
+    return ERROR;
+  }
+
+  if (game_pack_sprite(game, &game->media.ship_img) == ERROR ||
+      game_pack_sprite(game, &game->media.ship_bullet_img) == ERROR ||
+      game_pack_sprite(game, &game->media.martian_img) == ERROR ||
+      game_pack_sprite(game, &game->media.martian_bullet_img) == ERROR ||
+      game_pack_sprite(game, &game->media.martian_explosion_img) == ERROR ||
+      game_pack_sprite(game, &game->media.bunker_img) == ERROR ||
+      game_pack_sprite(game, &game->media.ufo_img) == ERROR) {
+    return ERROR;
+  }
+
+  game->media.bunker_image = atlas_reserve(game->media.atlas, NUM_BUNKERS * BUNKER_WIDTH,
+                                           BUNKER_HEIGHT);
+  if (!game->media.bunker_image) {
     return ERROR;
   }
 
+  // Entities of the same kind share one sprite descriptor
+  sprite_register(SPRITE_SHIP_BULLET, game->media.ship_bullet_img, BULLET_WIDTH, BULLET_HEIGHT);
+  sprite_register(SPRITE_MARTIAN_BULLET, game->media.martian_bullet_img, BULLET_WIDTH, BULLET_HEIGHT);
+  sprite_register(SPRITE_EXPLOSION, game->media.martian_explosion_img, EXPLOSION_WIDTH,
+                  EXPLOSION_HEIGHT);
+  sprite_register(SPRITE_UFO, game->media.ufo_img, UFO_WIDTH, UFO_HEIGHT);
+  sprite_register(SPRITE_BUNKER, game->media.bunker_img, BUNKER_PART_WIDTH, BUNKER_PART_HEIGHT);
+  sprite_register(SPRITE_SHIP, game->media.ship_img, SHIP_WIDTH, SHIP_HEIGHT);
+  sprite_register(SPRITE_MARTIAN, game->media.martian_img, MART_WIDTH, MART_HEIGHT);
+  sprite_register(SPRITE_BUNKER_IMAGE, game->media.bunker_image, BUNKER_WIDTH, BUNKER_HEIGHT);
+
   // Load sounds
-  game->samples[0] = al_load_sample(SND_SHOOT);
-  game->samples[1] = al_load_sample(SND_INVADER_KILLED);
-  game->samples[2] = al_load_sample(SND_SHIP_EXPLOSION);
-  game->samples[3] = al_load_sample(SND_MYSTERY_ENTERED);
-  game->samples[4] = al_load_sample(SND_MYSTERY_KILLED);
-  game->samples[5] = al_load_sample(SND_MOVE_0);
-  game->samples[6] = al_load_sample(SND_MOVE_1);
-  game->samples[7] = al_load_sample(SND_MOVE_2);
-  game->samples[8] = al_load_sample(SND_MOVE_3);
+  game->media.samples[0] = al_load_sample(SND_SHOOT);
+  game->media.samples[1] = al_load_sample(SND_INVADER_KILLED);
+  game->media.samples[2] = al_load_sample(SND_SHIP_EXPLOSION);
+  game->media.samples[3] = al_load_sample(SND_MYSTERY_ENTERED);
+  game->media.samples[4] = al_load_sample(SND_MYSTERY_KILLED);
+  game->media.samples[5] = al_load_sample(SND_MOVE_0);
+  game->media.samples[6] = al_load_sample(SND_MOVE_1);
+  game->media.samples[7] = al_load_sample(SND_MOVE_2);
+  game->media.samples[8] = al_load_sample(SND_MOVE_3);
+
+  game->media.font = al_load_ttf_font(FONT_RSC, 18, 0);
+  if (!game->media.font) {
+    return ERROR;
+  }
 
-  game->font = al_load_ttf_font(FONT_RSC, 18, 0);
-  if (!game->font) {
+  game->media.texts = textcache_create(game->media.font, NUM_TEXT_SLOTS);
+  if (!game->media.texts) {
     return ERROR;
   }
 
-  game->event_queue = al_create_event_queue();
-  if (!game->event_queue) {
+  game->media.event_queue = al_create_event_queue();
+  if (!game->media.event_queue) {
     return ERROR;
   }
 
-  game->ship = ship_create(game->ship_img, SHIP_WIDTH, SHIP_HEIGHT, SHIP_INIT_POS_X,
-                           SHIP_INIT_POS_Y, NO_DIR, SHIP_LIFE);
+  return OK;
+}
+
+/**
+ * @brief Creates the ship, formation and bunkers and loads the scores.
+ *
+ * Needs the sprite descriptors: their sizes drive the collisions, and the
+ * bunker sheet gives the bunker shape.
+ *
+ * @param game Pointer to the GAME instance.
+ * @return OK if initialization succeeds, ERROR if any setup fails.
+ */
+static STATUS game_init_sim(GAME *game) {
+  game->ship = ship_create(game->media.ship_img, SHIP_WIDTH, SHIP_HEIGHT,
+                           INT_TO_FIXED(SHIP_INIT_POS_X), INT_TO_FIXED(SHIP_INIT_POS_Y),
+                           NO_DIR, SHIP_LIFE);
   if (!game->ship) {
     return ERROR;
   }
 
-  game->level = 1;
-  game->high_score = 0;
-  game->paused = false;
-  game->p_was_down = false;
+  game->formation = form_create(NUM_ENEMY_X, NUM_ENEMY_Y);
+  if (!game->formation) {
+    return ERROR;
+  }
 
-  game->ship_exploding = false;
-  game->ship_explosion_timer = 0;
-  game->state = STATE_TITLE;
+  game->sim.level = 1;
+  game->ui.high_score = 0;
+  game->sim.paused = false;
+  game->sim.p_was_down = false;
+
+  game->sim.ship_exploding = false;
+  game->sim.ship_explosion_timer = 0;
+  game->sim.state = STATE_TITLE;
 
   // Create enemies
   if (game_reset_enemies(game) == ERROR) {
@@ -849,832 +1257,1566 @@ STATUS game_init(GAME *game, float FPS) {
 }
 
 /**
- * @brief Returns the main display of the game.
+ * @brief Initializes the game with provided FPS and sets up the display,
+ * bitmaps, fonts, and other resources.
+ *
+ * This function loads images, initializes timers, creates the player ship,
+ * and generates enemy instances.
  *
  * @param game Pointer to the GAME instance.
- * @return Pointer to ALLEGRO_DISPLAY or NULL if game is NULL.
+ * @param FPS Frames per second setting for the game.
+ * @return OK if initialization succeeds, ERROR if any setup fails.
  */
-ALLEGRO_DISPLAY *game_get_screen(GAME *game) {
+STATUS game_init(GAME *game, float FPS) {
   if (!game) {
-    return NULL;
+    return ERROR;
   }
 
-  return game->screen;
+  if (game_init_media(game, FPS) == ERROR) {
+    return ERROR;
+  }
+
+  return game_init_sim(game);
 }
 
 /**
- * @brief Returns the main timer of the game.
+ * @brief Initializes the game for headless runs: simulation only.
+ *
+ * No display, timer, event queue, atlas, font or sound is created, so it
+ * works on machines without a screen; only the Allegro core and image
+ * addon are needed. The sprite descriptors get their sizes without
+ * bitmaps, except the bunker sheet, which is loaded as a memory bitmap
+ * because it holds the bunker shape. Audio is turned off. Such a game can
+ * be stepped with game_update() and game_skip_quiet_ticks(), but not
+ * rendered.
  *
  * @param game Pointer to the GAME instance.
- * @return Pointer to ALLEGRO_TIMER or NULL if game is NULL.
+ * @return OK if initialization succeeds, ERROR if any setup fails.
  */
-ALLEGRO_TIMER *game_get_timer(GAME *game) {
+STATUS game_init_headless(GAME *game) {
   if (!game) {
-    return NULL;
+    return ERROR;
   }
 
-  return game->timer;
-}
+  game->media.audio = false;
 
-/**
- * @brief Returns the event queue for the game.
+  game->media.bunker_img = al_load_bitmap(BUNKER_IMG_RSC);
+  if (!game->media.bunker_img) {
+    return ERROR;
+  }
+  al_convert_mask_to_alpha(game->media.bunker_img, al_map_rgb(255, 0, 255));
+
+  sprite_register(SPRITE_SHIP_BULLET, NULL, BULLET_WIDTH, BULLET_HEIGHT);
+  sprite_register(SPRITE_MARTIAN_BULLET, NULL, BULLET_WIDTH, BULLET_HEIGHT);
+  sprite_register(SPRITE_EXPLOSION, NULL, EXPLOSION_WIDTH, EXPLOSION_HEIGHT);
+  sprite_register(SPRITE_UFO, NULL, UFO_WIDTH, UFO_HEIGHT);
+  sprite_register(SPRITE_BUNKER, game->media.bunker_img, BUNKER_PART_WIDTH, BUNKER_PART_HEIGHT);
+  sprite_register(SPRITE_SHIP, NULL, SHIP_WIDTH, SHIP_HEIGHT);
+  sprite_register(SPRITE_MARTIAN, NULL, MART_WIDTH, MART_HEIGHT);
+  sprite_register(SPRITE_BUNKER_IMAGE, NULL, BUNKER_WIDTH, BUNKER_HEIGHT);
+
+  return game_init_sim(game);
+}
+
+/**
+ * @brief Returns the main display of the game.
  *
  * @param game Pointer to the GAME instance.
- * @return Pointer to ALLEGRO_EVENT_QUEUE or NULL if game is NULL.
+ * @return Pointer to ALLEGRO_DISPLAY or NULL if game is NULL.
  */
-ALLEGRO_EVENT_QUEUE *game_get_ev_queue(GAME *game) {
+ALLEGRO_DISPLAY *game_get_screen(GAME *game) {
   if (!game) {
     return NULL;
   }
 
-  return game->event_queue;
+  return game->media.screen;
 }
 
 /**
- * @brief Returns the latest event from the game's event structure.
+ * @brief Returns the main timer of the game.
  *
  * @param game Pointer to the GAME instance.
- * @return Pointer to ALLEGRO_EVENT or NULL if game is NULL.
+ * @return Pointer to ALLEGRO_TIMER or NULL if game is NULL.
  */
-ALLEGRO_EVENT *game_get_event(GAME *game) {
+ALLEGRO_TIMER *game_get_timer(GAME *game) {
   if (!game) {
     return NULL;
   }
 
-  return &game->events;
+  return game->media.timer;
 }
 
 /**
- * @brief Checks if the game has finished.
+ * @brief Returns the event queue for the game.
  *
  * @param game Pointer to the GAME instance.
- * @return true if the game is marked as done, false otherwise.
+ * @return Pointer to ALLEGRO_EVENT_QUEUE or NULL if game is NULL.
  */
-bool game_is_done(GAME *game) {
+ALLEGRO_EVENT_QUEUE *game_get_ev_queue(GAME *game) {
   if (!game) {
-    return true;
+    return NULL;
   }
 
-  return game->done;
+  return game->media.event_queue;
 }
 
-// =========================================================================
-// Functions: Enemy Management - Shooting, Movement, and Destruction
-// =========================================================================
-
 /**
- * @brief Sets a randomly chosen martian as the shooter.
+ * @brief Seeds the game's random sequence.
+ *
+ * Two games with the same seed and the same inputs play out identically.
  *
  * @param game Pointer to the GAME instance.
- * @param last_rand Index of the randomly chosen martian.
+ * @param seed Seed of the sequence.
  * @return OK if successful, ERROR if game is NULL.
  */
-STATUS game_set_rand_enemy(GAME *game, int last_rand) {
+STATUS game_set_seed(GAME *game, unsigned seed) {
   if (!game) {
     return ERROR;
   }
 
-  game->last_enemy_rand = last_rand;
+  game->sim.rng = seed;
 
   return OK;
 }
 
 /**
- * @brief Initiates a shooting action for the specified martian.
+ * @brief Enables or disables sound playback.
+ *
+ * Headless runs (bots, simulations) disable audio; the game logic does not
+ * depend on it.
  *
  * @param game Pointer to the GAME instance.
- * @param i Index of the martian to shoot.
- * @return OK if successful, ERROR if the game or index is invalid.
+ * @param enabled true to play samples, false to stay silent.
+ * @return OK if successful, ERROR if game is NULL.
  */
-STATUS game_martian_shoot(GAME *game, int i) {
+STATUS game_set_audio(GAME *game, bool enabled) {
   if (!game) {
     return ERROR;
   }
 
-  if (i < 0 || i >= MAX_ENEMIES) {
-    return ERROR;
-  }
+  game->media.audio = enabled;
 
-  return mart_shoot(game->enemy[i], game->martian_bullet_img);
+  return OK;
 }
 
 /**
- * @brief Moves all martians by the specified speed and updates their direction
- * as necessary.
+ * @brief Enables or disables saving the high score and top scores to disk.
  *
- * This function adjusts the movement of all martians and ensures that
- * direction changes occur when they reach screen boundaries.
+ * Headless runs disable it so bot games never replace the player's scores.
+ * Scores are still loaded and kept in memory.
  *
  * @param game Pointer to the GAME instance.
- * @param speed Movement speed for the martians.
+ * @param enabled true to save scores, false to keep them in memory only.
  * @return OK if successful, ERROR if game is NULL.
  */
-STATUS game_move_martians(GAME *game, float speed) {
-  MARTIAN *martian = NULL;
-  int right_limit = (CANVAS_WIDTH - RIGHT_MARGIN);
-  int left_limit = FRAME_WIDTH;
-  int bottom_limit = (DISPLAY_HEIGHT - (FRAME_WIDTH * 2)) - 10;
-  int cx, cy;
-
+STATUS game_set_persistence(GAME *game, bool enabled) {
   if (!game) {
     return ERROR;
   }
 
-  if (game->enemies_dir != NO_DIR) {
-    for (int i = 0; i < game->num_enemies_alive && game->enemy[i] != NULL; i++) {
-      martian = game->enemy[i];
-      cx = mart_get_x(martian);
-      cy = mart_get_y(martian);
-
-      if (game->enemies_dir == DOWN) {
-        if (cx + speed >= right_limit) {
-          game->enemies_dir = LEFT;
-          i = game->num_enemies_alive; // Break
-        } else if (cx - speed <= left_limit) {
-          game->enemies_dir = RIGHT;
-          i = game->num_enemies_alive;
-        }
-
-      } else if (cx + speed >= right_limit || cx - speed <= left_limit) {
-        game->enemies_dir = DOWN;
-        i = game->num_enemies_alive;
-
-      } else if (cy + MART_HEIGHT >= bottom_limit) {
-        game_save_highscore(game);
-        game->state = STATE_GAME_OVER;
-        i = game->num_enemies_alive;
-      }
-    }
-
-    for (int i = 0; i < game->num_enemies_alive && game->enemy[i] != NULL;
-         i++) {
-      martian = game->enemy[i];
-      mart_move(martian, speed);
-    }
-  }
+  game->media.persist = enabled;
 
   return OK;
 }
 
 /**
- * @brief Destroys a specific martian and removes it from the game.
+ * @brief Enables or disables the dirty-rectangle renderer.
  *
- * The function also shifts remaining enemies in the array to fill the
- * empty position.
+ * With it, each frame only redraws the parts of the screen where a sprite
+ * was or is now, a bunker lost pixels or a HUD number changed, patching a
+ * persistent copy of the screen that is then presented whole. It is turned on by
+ * game_init() when bitmaps end up in memory (no GPU acceleration), where
+ * full-screen blits dominate the frame time.
  *
  * @param game Pointer to the GAME instance.
- * @param i Index of the martian to destroy.
- * @return OK if successful, ERROR if the game or index is invalid.
+ * @param enabled true to redraw only what changed, false to redraw every frame.
+ * @return OK if successful, ERROR if game is NULL.
  */
-STATUS game_destroy_martian(GAME *game, int i) {
-  if (!game || game->num_enemies_alive <= 0) {
+STATUS game_set_dirty_rects(GAME *game, bool enabled) {
+  if (!game) {
     return ERROR;
   }
 
-  if (i < 0 || i >= game->num_enemies_alive) {
-    return ERROR;
-  }
+  game->media.dirty_rects = enabled;
+  game->media.canvas_valid = false;
 
-  if (mart_destroy(game->enemy[i]) == ERROR) {
-    return ERROR;
-  }
+  return OK;
+}
 
-  // Shift remaining enemies forward
-  for (int j = i; j < game->num_enemies_alive - 1; j++) {
-    game->enemy[j] = game->enemy[j + 1];
+/**
+ * @brief Returns the latest event from the game's event structure.
+ *
+ * @param game Pointer to the GAME instance.
+ * @return Pointer to ALLEGRO_EVENT or NULL if game is NULL.
+ */
+ALLEGRO_EVENT *game_get_event(GAME *game) {
+  if (!game) {
+    return NULL;
   }
 
-  game->enemy[game->num_enemies_alive - 1] = NULL;
+  return &game->media.events;
+}
 
-  game->num_enemies_destroyed++;
-  game->num_enemies_alive--;
+/**
+ * @brief Checks if the game has finished.
+ *
+ * @param game Pointer to the GAME instance.
+ * @return true if the game is marked as done, false otherwise.
+ */
+bool game_is_done(GAME *game) {
+  if (!game) {
+    return true;
+  }
 
-  return OK;
+  return game->sim.done;
 }
 
 // =========================================================================
-// Functions: Orphan Bullet Management - Adding, Moving, and Removing
+// Functions: Enemy Management - Shooting, Movement, and Destruction
 // =========================================================================
 
 /**
- * @brief Adds an orphan bullet to the game's orphan bullet list.
+ * @brief Ticks between two martian shots.
+ *
+ * Dynamic frequency: increases with fewer enemies and higher level.
  *
  * @param game Pointer to the GAME instance.
- * @param bullet Pointer to the BULLET to be added.
- * @return OK if the bullet is added successfully, ERROR if game, bullet,
- *         or the limit of orphan bullets is exceeded.
+ * @return Shot interval in ticks.
  */
-STATUS game_add_orphan_bullet(GAME *game, BULLET *bullet) {
-  if (!game || !bullet || game->num_orphan_bullets >= MAX_ORP_BULLETS) {
-    return ERROR;
-  }
+static int game_shoot_interval(GAME *game) {
+  float alive = (float)game->sim.num_enemies_alive / form_get_size(game->formation);
+  int dyn_freq = MART_SHOOT_FREQ
+      - (int)((MART_SHOOT_FREQ - MART_SHOOT_FREQ_MIN) * (1.0f - alive))
+      - (game->sim.level - 1) * 5;
+  if (dyn_freq < MART_SHOOT_FREQ_MIN) dyn_freq = MART_SHOOT_FREQ_MIN;
+
+  return dyn_freq;
+}
 
-  game->orphan_bullets[game->num_orphan_bullets] = bullet;
-  game->num_orphan_bullets++;
+/**
+ * @brief Share of martians left, scaled down on later waves.
+ *
+ * Level multiplier increases base speed each wave (arcade: ~10% per wave).
+ *
+ * @param game Pointer to the GAME instance.
+ * @return Ratio in (0, 1]; smaller means faster martians.
+ */
+static float game_martian_ratio(GAME *game) {
+  float level_factor = 1.0f - (game->sim.level - 1) * 0.10f;
+  if (level_factor < 0.15f) level_factor = 0.15f;
 
-  return OK;
+  return (float)game->sim.num_enemies_alive / form_get_size(game->formation) * level_factor;
 }
 
 /**
- * @brief Removes and returns the first orphan bullet in the game.
+ * @brief Ticks between two martian steps.
+ *
+ * In the original arcade, speed scales by reducing the interval between steps.
+ * Exponential scaling makes the last few enemies dramatically faster.
  *
- * Dequeues an orphan bullet, shifts the remaining bullets forward, and
- * decreases the orphan bullet count.
+ * @param ratio Value of game_martian_ratio().
+ * @return Step interval in ticks.
+ */
+static int game_move_interval(float ratio) {
+  int dyn_move_timer = (int)(MART_MOVE_TIMER * ratio * ratio);
+  if (dyn_move_timer < MART_MOVE_TIMER_MIN) dyn_move_timer = MART_MOVE_TIMER_MIN;
+
+  return dyn_move_timer;
+}
+
+/**
+ * @brief Sets a randomly chosen martian as the shooter.
  *
  * @param game Pointer to the GAME instance.
- * @return Pointer to the removed bullet or NULL if there are no orphan bullets.
+ * @param last_rand Index of the randomly chosen martian.
+ * @return OK if successful, ERROR if game is NULL.
  */
-BULLET *game_dequeue_orphan_bullet(GAME *game) {
-  return game_extract_orphan_bullet_at(game, 0);
+STATUS game_set_rand_enemy(GAME *game, int last_rand) {
+  if (!game) {
+    return ERROR;
+  }
+
+  game->sim.last_enemy_rand = last_rand;
+
+  return OK;
 }
 
 /**
- * @brief Removes and returns a specific orphan bullet at index i.
+ * @brief Fires a bullet from the player's ship.
+ *
+ * Only MAX_SHIP_BULLETS player bullets can be in flight at once.
  *
  * @param game Pointer to the GAME instance.
- * @param i Index of the orphan bullet to extract.
- * @return Pointer to the extracted bullet or NULL if index is invalid.
+ * @return OK if a bullet was fired, ERROR if the limit is reached or on
+ *         failure.
  */
-BULLET *game_extract_orphan_bullet_at(GAME *game, int i) {
+STATUS game_ship_shoot(GAME *game) {
   BULLET *bullet = NULL;
 
-  if (game != NULL && i >= 0 && i < game->num_orphan_bullets) {
-    bullet = game->orphan_bullets[i];
+  if (!game || game->sim.num_ship_bullets >= MAX_SHIP_BULLETS) {
+    return ERROR;
+  }
 
-    for (int j = i; j < game->num_orphan_bullets - 1; j++) {
-      game->orphan_bullets[j] = game->orphan_bullets[j + 1];
-    }
+  bullet = ship_shoot(game->ship);
+  if (!bullet) {
+    return ERROR;
+  }
 
-    game->num_orphan_bullets--;
-    game->orphan_bullets[game->num_orphan_bullets] = NULL;
+  if (game_add_bullet(game, bullet) == ERROR) {
+    bullet_destroy(bullet);
+    return ERROR;
   }
 
-  return bullet;
+  return OK;
 }
 
 /**
- * @brief Retrieves the orphan bullet at the specified index.
+ * @brief Initiates a shooting action for the specified martian.
  *
  * @param game Pointer to the GAME instance.
- * @param i Index of the orphan bullet.
- * @return Pointer to the bullet at index i or NULL if index is out of range.
+ * @param i Index of the martian to shoot.
+ * @return OK if successful, ERROR if the game or index is invalid.
  */
-BULLET *game_get_orphan_bullet_at(GAME *game, int i) {
-  if (!game || i < 0 || i >= game->num_orphan_bullets) {
-    return NULL;
+STATUS game_martian_shoot(GAME *game, int i) {
+  if (!game) {
+    return ERROR;
+  }
+
+  if (i < 0 || i >= form_get_size(game->formation)) {
+    return ERROR;
+  }
+
+  // The chosen cell may have been emptied since it was picked
+  if (!form_is_alive(game->formation, i)) {
+    return OK;
+  }
+
+  // Skip the shot while the bullet array is full
+  if (slotmap_size(game->bullets) >= MAX_BULLETS) {
+    return OK;
+  }
+
+  BULLET *bullet = bullet_create(SPRITE_MARTIAN_BULLET,
+                                 form_get_cell_x(game->formation, i) + INT_TO_FIXED(12),
+                                 form_get_cell_y(game->formation, i), DOWN,
+                                 BULLET_MARTIAN);
+  if (!bullet) {
+    return ERROR;
   }
 
-  return game->orphan_bullets[i];
+  return game_add_bullet(game, bullet);
 }
 
 /**
- * @brief Moves all orphan bullets in the game by a specified speed.
+ * @brief Moves all martians by the specified speed and updates their direction
+ * as necessary.
  *
- * If a bullet exceeds the bottom limit, it is removed from the orphan bullets
- * list.
+ * Edge and invasion checks compare the formation bounding box against the
+ * limits, so they cost the same for any number of martians; the step
+ * itself only moves the formation origin.
  *
  * @param game Pointer to the GAME instance.
- * @param speed Movement speed of the orphan bullets.
+ * @param speed Movement speed for the martians.
  * @return OK if successful, ERROR if game is NULL.
  */
-STATUS game_move_orphan_bullets(GAME *game, float speed) {
-  int bottom_limit = CANVAS_HEIGHT;
+STATUS game_move_martians(GAME *game, FIXED speed) {
+  FORMATION *formation = NULL;
+  FIXED right_limit = INT_TO_FIXED(CANVAS_WIDTH - RIGHT_MARGIN);
+  FIXED left_limit = INT_TO_FIXED(FRAME_WIDTH);
+  FIXED bottom_limit = INT_TO_FIXED((DISPLAY_HEIGHT - (FRAME_WIDTH * 2)) - 10);
+  bool at_right, at_left, at_bottom;
+  int dir;
 
   if (!game) {
     return ERROR;
   }
 
-  for (int i = game->num_orphan_bullets - 1; i >= 0; i--) {
-    if (bullet_get_y(game->orphan_bullets[i]) + speed < bottom_limit) {
-      if (bullet_move(game->orphan_bullets[i], speed) == ERROR) {
-        return ERROR;
-      }
-    } else {
-      if (bullet_destroy(game_extract_orphan_bullet_at(game, i)) == ERROR) {
-        return ERROR;
+  formation = game->formation;
+  dir = form_get_dir(formation);
+
+  if (dir != NO_DIR) {
+    if (!form_is_empty(formation)) {
+      at_right = form_get_right(formation) + speed >= right_limit;
+      at_left = form_get_left(formation) - speed <= left_limit;
+      at_bottom = form_get_bottom(formation) + INT_TO_FIXED(MART_HEIGHT) >= bottom_limit;
+
+      if (dir == DOWN) {
+        if (at_right) {
+          form_set_dir(formation, LEFT);
+        } else if (at_left) {
+          form_set_dir(formation, RIGHT);
+        }
+
+      } else if (at_right || at_left) {
+        form_set_dir(formation, DOWN);
+
+      } else if (at_bottom) {
+        game_save_highscore(game);
+        game->sim.state = STATE_GAME_OVER;
       }
     }
+
+    form_move(formation, speed);
   }
 
   return OK;
 }
 
-// =========================================================================
-// Functions: Object Management - Adding, Retrieving, and Removing Game Objects
-// =========================================================================
-
 /**
- * @brief Adds an object to the game's object list.
+ * @brief Destroys a specific martian and removes it from the game.
+ *
+ * The cell is marked dead in the formation; no other martian moves. The
+ * bullets it already fired stay in flight in the game's bullet array.
  *
  * @param game Pointer to the GAME instance.
- * @param object Pointer to the OBJECT to be added.
- * @return OK if the object is added successfully, ERROR if game, object,
- *         or the limit of objects is exceeded.
+ * @param i Cell index of the martian to destroy.
+ * @return OK if successful, ERROR if the game or index is invalid.
  */
-STATUS game_add_object(GAME *game, OBJECT *object) {
-  if (!game || !object || game->num_objects >= MAX_OBJECTS) {
+STATUS game_destroy_martian(GAME *game, int i) {
+  if (!game || game->sim.num_enemies_alive <= 0) {
     return ERROR;
   }
 
-  game->objects[game->num_objects] = object;
-  game->num_objects++;
+  if (i < 0 || i >= form_get_size(game->formation) || !form_is_alive(game->formation, i)) {
+    return ERROR;
+  }
+
+  form_kill(game->formation, i);
+
+  game->sim.num_enemies_destroyed++;
+  game->sim.num_enemies_alive--;
 
   return OK;
 }
 
+// =========================================================================
+// Functions: Bullet Management - Adding, Moving, and Removing
+// =========================================================================
+
 /**
- * @brief Removes and returns the first object in the game's object list.
+ * @brief Moves a falling martian bullet makes before it can touch [top, bottom).
  *
- * Dequeues an object, shifts the remaining objects forward, and decreases the
- * object count.
+ * Rounded down, so the bullet is tested on or before its first contact.
  *
- * @param game Pointer to the GAME instance.
- * @return Pointer to the removed object or NULL if there are no objects.
+ * @param bullet Martian bullet.
+ * @param top Top of the target.
+ * @param bottom Bottom of the target (exclusive).
+ * @return Number of moves, 0 if it already touches the target, or
+ *         BULLET_NEVER_DUE if it is past it.
  */
-OBJECT *game_dequeue_object(GAME *game) {
-  return game_extract_object_at(game, 0);
+static unsigned game_moves_to_reach(const BULLET *bullet, FIXED top, FIXED bottom) {
+  FIXED y = bullet_y(bullet);
+  FIXED end = y + INT_TO_FIXED(bullet_height(bullet));
+
+  if (y >= bottom) {
+    return BULLET_NEVER_DUE;
+  }
+
+  return end >= top ? 0 : (unsigned)((top - end) / INT_TO_FIXED(MART_BULLET_SPEED));
 }
 
 /**
- * @brief Removes and returns a specific object at index i.
+ * @brief Earliest tick at which a bullet can touch a static target.
+ *
+ * Bullets move straight at a constant speed, and bunkers and the ship's
+ * row never move, so the first tick a martian bullet can reach one of them
+ * is known in advance. Bunker pixels are only ever removed, so the answer
+ * stays a lower bound as bunkers wear away. The ship moves sideways only:
+ * its whole row counts as a target. Player bullets may meet martians, the
+ * UFO or martian bullets, which all move, so they are due every tick.
  *
  * @param game Pointer to the GAME instance.
- * @param i Index of the object to extract.
- * @return Pointer to the extracted object or NULL if index is invalid.
+ * @param bullet Bullet to schedule.
+ * @param after First tick the bullet may be due.
+ * @return Tick at which the bullet must next be tested, or BULLET_NEVER_DUE.
  */
-OBJECT *game_extract_object_at(GAME *game, int i) {
-  OBJECT *object = NULL;
+static unsigned game_bullet_due_tick(GAME *game, BULLET *bullet, unsigned after) {
+  FIXED x0 = bullet_x(bullet), x1 = x0 + INT_TO_FIXED(bullet_width(bullet));
+  unsigned moves = BULLET_NEVER_DUE;
+
+  if (bullet_owner(bullet) == BULLET_SHIP) {
+    return after;
+  }
 
-  if (game != NULL && i >= 0 && i < game->num_objects) {
-    object = game->objects[i];
+  if (game->ship) {
+    FIXED top = ship_get_y(game->ship);
+    moves = game_moves_to_reach(bullet, top, top + INT_TO_FIXED(ship_get_height(game->ship)));
+  }
 
-    for (int j = i; j < game->num_objects - 1; j++) {
-      game->objects[j] = game->objects[j + 1];
+  for (int j = 0; j < NUM_BUNKERS; j++) {
+    BUNKER *bunker = game->bunkers[j];
+
+    if (bunker && x0 < bunker_x(bunker) + INT_TO_FIXED(BUNKER_WIDTH) && bunker_x(bunker) < x1) {
+      unsigned m = game_moves_to_reach(bullet, bunker_y(bunker),
+                                       bunker_y(bunker) + INT_TO_FIXED(BUNKER_HEIGHT));
+      if (m < moves) {
+        moves = m;
+      }
     }
+  }
 
-    game->num_objects--;
-    game->objects[game->num_objects] = NULL;
+  if (moves == BULLET_NEVER_DUE) {
+    return BULLET_NEVER_DUE;
   }
 
-  return object;
+  return game->sim.bullet_tick + moves > after ? game->sim.bullet_tick + moves : after;
 }
 
 /**
- * @brief Retrieves the object at the specified index.
+ * @brief Drops the schedule entries of bullets that are gone.
+ *
+ * Entries are not removed when their bullet dies, so the schedule is
+ * cleaned up only when it fills.
  *
  * @param game Pointer to the GAME instance.
- * @param i Index of the object.
- * @return Pointer to the object at index i or NULL if index is out of range.
  */
-OBJECT *game_get_object_at(GAME *game, int i) {
-  if (!game || i < 0 || i >= game->num_objects) {
-    return NULL;
+static void game_prune_schedule(GAME *game) {
+  BULLET_SCHEDULE *schedule = &game->schedule;
+  int live = 0;
+
+  for (int k = 0; k < bullet_schedule_size(schedule); k++) {
+    if (slotmap_get(game->bullets, schedule->items[k].bullet)) {
+      schedule->items[live++] = schedule->items[k];
+    }
   }
 
-  return game->objects[i];
+  // Pushing item k only touches positions <= k, so the heap is rebuilt in place
+  bullet_schedule_clear(schedule);
+  for (int k = 0; k < live; k++) {
+    bullet_schedule_push(schedule, schedule->items[k]);
+  }
 }
 
-STATUS callback_left(GAME *game) {
-  if (!game)
-    return ERROR;
+/**
+ * @brief Queues a bullet for its next collision test.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param handle Handle of the bullet.
+ * @param after First tick the bullet may be due.
+ * @return OK if successful, ERROR if the schedule is full.
+ */
+static STATUS game_schedule_bullet(GAME *game, SLOT_HANDLE handle, unsigned after) {
+  BULLET_DUE entry = {game_bullet_due_tick(game, slotmap_get(game->bullets, handle), after),
+                      handle};
 
-  float x = ship_get_x(game->ship);
+  if (entry.tick == BULLET_NEVER_DUE) {
+    return OK;
+  }
 
-  if (x - SHIP_SPEED >= FRAME_WIDTH) {
-    ship_set_dir(game->ship, LEFT);
-    ship_move(game->ship, -SHIP_SPEED);
+  if (bullet_schedule_is_full(&game->schedule)) {
+    game_prune_schedule(game);
   }
 
-  return OK;
+  return bullet_schedule_push(&game->schedule, entry);
 }
 
 /**
- * @brief Moves the player's ship to the right.
+ * @brief Adds a bullet to the game's bullet array.
  *
- * Checks if the ship can move right within bounds and updates its direction.
+ * Ship and martian bullets share one packed array; each bullet carries its
+ * owner and direction. The bullet is also queued for its first collision
+ * test.
  *
  * @param game Pointer to the GAME instance.
- * @return OK if movement is successful, ERROR if game is NULL.
+ * @param bullet Pointer to the BULLET to be added.
+ * @return OK if the bullet is added successfully, ERROR if game, bullet,
+ *         or the limit of bullets is exceeded.
  */
-STATUS callback_right(GAME *game) {
-  if (!game)
+STATUS game_add_bullet(GAME *game, BULLET *bullet) {
+  if (!game || !bullet) {
     return ERROR;
+  }
 
-  float x = ship_get_x(game->ship);
+  SLOT_HANDLE handle = slotmap_insert(game->bullets, bullet);
+  if (handle == SLOT_HANDLE_NONE) {
+    return ERROR;
+  }
 
-  if (x + SHIP_SPEED <= (CANVAS_WIDTH - RIGHT_MARGIN)) {
-    ship_set_dir(game->ship, RIGHT);
-    ship_move(game->ship, SHIP_SPEED);
+  if (bullet_get_owner(bullet) == BULLET_SHIP) {
+    game->sim.num_ship_bullets++;
   }
 
-  return OK;
+  return game_schedule_bullet(game, handle, game->sim.bullet_tick);
 }
 
 /**
- * @brief Triggers the ship's shooting action.
+ * @brief Removes and returns a specific bullet at index i.
+ *
+ * The last bullet is moved into the freed slot, so removal takes constant
+ * time.
  *
  * @param game Pointer to the GAME instance.
- * @return OK if shooting is successful, ERROR if game or ship's bullet image is
- * NULL.
+ * @param i Index of the bullet to extract.
+ * @return Pointer to the extracted bullet or NULL if index is invalid.
  */
-STATUS callback_space(GAME *game) {
+BULLET *game_extract_bullet_at(GAME *game, int i) {
+  BULLET *bullet = NULL;
+
   if (!game) {
-    return ERROR;
+    return NULL;
   }
 
-  if (ship_shoot(game->ship, game->ship_bullet_img) == ERROR) {
-    return ERROR;
+  bullet = slotmap_remove_at(game->bullets, i);
+  if (bullet && bullet_get_owner(bullet) == BULLET_SHIP) {
+    game->sim.num_ship_bullets--;
   }
 
-  return OK;
+  return bullet;
 }
 
-// =========================================================================
-// Functions: Game Update - Ship and Martian Actions, Collision Detection
-// =========================================================================
-
-// To increase difficulty, raise enemy cadence and speed, and reduce ship's
 /**
- * @brief Updates the player ship: movement, shooting, and bullet movement.
+ * @brief Destroys the bullet at index i, leaving an empty slot.
  *
- * Handles keyboard input for left/right movement with bounds checking,
- * space for shooting with sound, and moves active ship bullets upward.
+ * The slot keeps its index until game_compact_bullets() is called.
  *
  * @param game Pointer to the GAME instance.
- * @param key Pointer to the current keyboard state.
- * @return OK if update is successful, ERROR if game or key is NULL.
+ * @param i Index of the bullet to destroy.
+ * @return OK if successful, ERROR if the index is invalid or already empty.
  */
-STATUS game_ship_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key) {
-  if (!game || !key) {
+STATUS game_kill_bullet_at(GAME *game, int i) {
+  BULLET *bullet = NULL;
+
+  if (!game) {
     return ERROR;
   }
 
-  if (al_key_down(key, ALLEGRO_KEY_LEFT)) {
-    callback_left(game);
-  } else if (al_key_down(key, ALLEGRO_KEY_RIGHT)) {
-    callback_right(game);
-  } else {
-    ship_set_dir(game->ship, NO_DIR);
+  bullet = slotmap_clear_at(game->bullets, i);
+  if (!bullet) {
+    return ERROR;
+  }
+
+  if (bullet_get_owner(bullet) == BULLET_SHIP) {
+    game->sim.num_ship_bullets--;
+  }
+
+  return bullet_destroy(bullet);
+}
+
+/**
+ * @brief Removes the empty slots left by game_kill_bullet_at().
+ *
+ * @param game Pointer to the GAME instance.
+ * @return OK if successful, ERROR if game is NULL.
+ */
+STATUS game_compact_bullets(GAME *game) {
+  if (!game) {
+    return ERROR;
+  }
+
+  return slotmap_compact(game->bullets);
+}
+
+/**
+ * @brief Retrieves the bullet at the specified index.
+ *
+ * Indexes change as bullets are removed; use game_get_bullet_handle_at()
+ * to keep a reference across ticks.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param i Index of the bullet.
+ * @return Pointer to the bullet at index i or NULL if index is out of range.
+ */
+BULLET *game_get_bullet_at(GAME *game, int i) {
+  if (!game) {
+    return NULL;
+  }
+
+  return slotmap_get_at(game->bullets, i);
+}
+
+/**
+ * @brief Gets a stable handle to the bullet at the specified index.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param i Index of the bullet.
+ * @return Handle of the bullet, or SLOT_HANDLE_NONE if index is invalid.
+ */
+SLOT_HANDLE game_get_bullet_handle_at(GAME *game, int i) {
+  if (!game) {
+    return SLOT_HANDLE_NONE;
   }
 
-  if (al_key_down(key, ALLEGRO_KEY_SPACE)) {
-    if (ship_shoot(game->ship, game->ship_bullet_img) == OK) {
-      al_play_sample(game->samples[0], 1.0, 0.0, 1.0, ALLEGRO_PLAYMODE_ONCE, NULL);
+  return slotmap_handle_at(game->bullets, i);
+}
+
+/**
+ * @brief Retrieves a bullet from its handle.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param handle Handle from game_get_bullet_handle_at().
+ * @return Pointer to the bullet, or NULL once the bullet is gone.
+ */
+BULLET *game_get_bullet(GAME *game, SLOT_HANDLE handle) {
+  if (!game) {
+    return NULL;
+  }
+
+  return slotmap_get(game->bullets, handle);
+}
+
+/**
+ * @brief Destroys every bullet fired by the given owner.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param owner Owner of the bullets to destroy.
+ * @return OK if successful, ERROR if game is NULL.
+ */
+STATUS game_clear_bullets(GAME *game, BULLET_OWNER owner) {
+  if (!game) {
+    return ERROR;
+  }
+
+  for (int i = slotmap_size(game->bullets) - 1; i >= 0; i--) {
+    if (bullet_get_owner(slotmap_get_at(game->bullets, i)) == owner) {
+      bullet_destroy(game_extract_bullet_at(game, i));
+    }
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Moves every bullet in flight in a single pass.
+ *
+ * Player bullets travel up at SHIP_BULLET_SPEED and martian bullets down
+ * at MART_BULLET_SPEED. Bullets leaving their playfield limit are removed.
+ *
+ * @param game Pointer to the GAME instance.
+ * @return OK if successful, ERROR if game is NULL.
+ */
+STATUS game_move_bullets(GAME *game) {
+  if (!game) {
+    return ERROR;
+  }
+
+  game->sim.bullet_tick++;
+
+  for (int i = slotmap_count(game->bullets) - 1; i >= 0; i--) {
+    BULLET *bullet = slotmap_at(game->bullets, i);
+    bool in_bounds;
+    FIXED speed;
+
+    if (bullet_owner(bullet) == BULLET_SHIP) {
+      speed = INT_TO_FIXED(SHIP_BULLET_SPEED);
+      in_bounds = bullet_y(bullet) - speed > INT_TO_FIXED(SHIP_BULLET_TOP_LIMIT);
+    } else {
+      speed = INT_TO_FIXED(MART_BULLET_SPEED);
+      in_bounds = bullet_y(bullet) + speed < INT_TO_FIXED(CANVAS_HEIGHT);
+    }
+
+    if (in_bounds) {
+      if (bullet_move(bullet, speed) == ERROR) {
+        return ERROR;
+      }
+    } else {
+      if (bullet_destroy(game_extract_bullet_at(game, i)) == ERROR) {
+        return ERROR;
+      }
     }
   }
 
-  if (ship_move_bullet(game->ship, SHIP_BULLET_SPEED) == ERROR) {
+  return OK;
+}
+
+// =========================================================================
+// Functions: Object Management - Adding, Retrieving, and Removing Game Objects
+// =========================================================================
+
+/**
+ * @brief Adds an object to the game's object list.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param object Pointer to the OBJECT to be added.
+ * @return OK if the object is added successfully, ERROR if game, object,
+ *         or the limit of objects is exceeded.
+ */
+STATUS game_add_object(GAME *game, OBJECT *object) {
+  if (!game || !object) {
+    return ERROR;
+  }
+
+  if (slotmap_insert(game->objects, object) == SLOT_HANDLE_NONE) {
+    return ERROR;
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Removes and returns the first object in the game's object list.
+ *
+ * Dequeues an object, shifts the remaining objects forward, and decreases the
+ * object count.
+ *
+ * @param game Pointer to the GAME instance.
+ * @return Pointer to the removed object or NULL if there are no objects.
+ */
+OBJECT *game_dequeue_object(GAME *game) {
+  return game_extract_object_at(game, 0);
+}
+
+/**
+ * @brief Removes and returns a specific object at index i.
+ *
+ * The last object is moved into the freed slot, so removal takes constant
+ * time.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param i Index of the object to extract.
+ * @return Pointer to the extracted object or NULL if index is invalid.
+ */
+OBJECT *game_extract_object_at(GAME *game, int i) {
+  if (!game) {
+    return NULL;
+  }
+
+  return slotmap_remove_at(game->objects, i);
+}
+
+/**
+ * @brief Retrieves the object at the specified index.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param i Index of the object.
+ * @return Pointer to the object at index i or NULL if index is out of range.
+ */
+OBJECT *game_get_object_at(GAME *game, int i) {
+  if (!game) {
+    return NULL;
+  }
+
+  return slotmap_get_at(game->objects, i);
+}
+
+/**
+ * @brief Gets a stable handle to the object at the specified index.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param i Index of the object.
+ * @return Handle of the object, or SLOT_HANDLE_NONE if index is invalid.
+ */
+SLOT_HANDLE game_get_object_handle_at(GAME *game, int i) {
+  if (!game) {
+    return SLOT_HANDLE_NONE;
+  }
+
+  return slotmap_handle_at(game->objects, i);
+}
+
+/**
+ * @brief Retrieves an object from its handle.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param handle Handle from game_get_object_handle_at().
+ * @return Pointer to the object, or NULL once the object is gone.
+ */
+OBJECT *game_get_object(GAME *game, SLOT_HANDLE handle) {
+  if (!game) {
+    return NULL;
+  }
+
+  return slotmap_get(game->objects, handle);
+}
+
+STATUS callback_left(GAME *game) {
+  if (!game)
+    return ERROR;
+
+  FIXED x = ship_get_x(game->ship);
+
+  if (x - INT_TO_FIXED(SHIP_SPEED) >= INT_TO_FIXED(FRAME_WIDTH)) {
+    ship_set_dir(game->ship, LEFT);
+    ship_move(game->ship, -INT_TO_FIXED(SHIP_SPEED));
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Moves the player's ship to the right.
+ *
+ * Checks if the ship can move right within bounds and updates its direction.
+ *
+ * @param game Pointer to the GAME instance.
+ * @return OK if movement is successful, ERROR if game is NULL.
+ */
+STATUS callback_right(GAME *game) {
+  if (!game)
     return ERROR;
+
+  FIXED x = ship_get_x(game->ship);
+
+  if (x + INT_TO_FIXED(SHIP_SPEED) <= INT_TO_FIXED(CANVAS_WIDTH - RIGHT_MARGIN)) {
+    ship_set_dir(game->ship, RIGHT);
+    ship_move(game->ship, INT_TO_FIXED(SHIP_SPEED));
   }
 
   return OK;
 }
 
 /**
- * @brief Updates the martians' movement, shooting, and bullet movement.
+ * @brief Triggers the ship's shooting action.
+ *
+ * @param game Pointer to the GAME instance.
+ * @return OK if shooting is successful, ERROR if game or ship's bullet image is
+ * NULL.
+ */
+STATUS callback_space(GAME *game) {
+  if (!game) {
+    return ERROR;
+  }
+
+  return game_ship_shoot(game);
+}
+
+// =========================================================================
+// Functions: Game Update - Ship and Martian Actions, Collision Detection
+// =========================================================================
+
+// To increase difficulty, raise enemy cadence and speed, and reduce ship's
+/**
+ * @brief Updates the player ship: movement and shooting.
+ *
+ * Handles left/right input for movement with bounds checking and the fire
+ * input for shooting with sound. Bullets are moved by game_move_bullets().
+ *
+ * @param game Pointer to the GAME instance.
+ * @param input Player input of the tick.
+ * @return OK if update is successful, ERROR if game or input is NULL.
+ */
+STATUS game_ship_update(GAME *game, const GAME_INPUT *input) {
+  if (!game || !input) {
+    return ERROR;
+  }
+
+  if (input->left) {
+    callback_left(game);
+  } else if (input->right) {
+    callback_right(game);
+  } else {
+    ship_set_dir(game->ship, NO_DIR);
+  }
+
+  if (input->fire) {
+    if (game_ship_shoot(game) == OK) {
+      game_play_sample(game, 0, 1.0, ALLEGRO_PLAYMODE_ONCE);
+    }
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Updates the martians' movement and shooting.
  *
  * Uses timers to control martian shooting and movement intervals.
  *
  * @param game Pointer to the GAME instance.
  * @return OK if update is successful, ERROR if game is NULL.
  */
-STATUS game_martians_update(GAME *game, float speed) {
+STATUS game_martians_update(GAME *game, FIXED speed) {
   static int move_sound_idx = 0;
 
   if (!game) {
     return ERROR;
   }
 
-  if (game->num_enemies_alive > 0) {
+  if (game->sim.num_enemies_alive > 0) {
     // Level start pause: enemies move but don't shoot for ~1.5s
-    if (game->level_start_delay > 0) {
-      game->level_start_delay--;
+    if (game->sim.level_start_delay > 0) {
+      game->sim.level_start_delay--;
     } else {
-      // Dynamic frequency: increases with fewer enemies and higher level
-      int dyn_freq = MART_SHOOT_FREQ
-          - (int)((MART_SHOOT_FREQ - MART_SHOOT_FREQ_MIN)
-                  * (1.0f - (float)game->num_enemies_alive / MAX_ENEMIES))
-          - (game->level - 1) * 5;
-      if (dyn_freq < MART_SHOOT_FREQ_MIN) dyn_freq = MART_SHOOT_FREQ_MIN;
-
-      if (++game->enemy_shoot_timer >= dyn_freq) {
-        if (game_martian_shoot(game, game->last_enemy_rand) == ERROR) {
+      if (++game->sim.enemy_shoot_timer >= game_shoot_interval(game)) {
+        if (game_martian_shoot(game, game->sim.last_enemy_rand) == ERROR) {
           return ERROR;
         }
-        game->enemy_shoot_timer = 0;
+        game->sim.enemy_shoot_timer = 0;
       }
     }
 
-    // In the original arcade, speed scales by reducing the interval between steps.
-    // Exponential scaling makes the last few enemies dramatically faster.
-    // Level multiplier increases base speed each wave (arcade: ~10% per wave).
-    float level_factor = 1.0f - (game->level - 1) * 0.10f;
-    if (level_factor < 0.15f) level_factor = 0.15f;
-    float ratio = (float)game->num_enemies_alive / MAX_ENEMIES * level_factor;
-    int dyn_move_timer = (int)(MART_MOVE_TIMER * ratio * ratio);
-    if (dyn_move_timer < MART_MOVE_TIMER_MIN) dyn_move_timer = MART_MOVE_TIMER_MIN;
+    float ratio = game_martian_ratio(game);
 
-    if (++game->enemy_move_timer >= dyn_move_timer) {
+    if (++game->sim.enemy_move_timer >= game_move_interval(ratio)) {
       game_move_martians(game, speed);
-      game->enemy_move_timer = 0;
+      game->sim.enemy_move_timer = 0;
 
       // Movement sound (cycling 0-3), pitch increases with fewer enemies
       float sound_speed = 1.0f + (1.0f - ratio) * 0.6f;
-      al_play_sample(game->samples[5 + move_sound_idx], 1.0, 0.0, sound_speed, ALLEGRO_PLAYMODE_ONCE, NULL);
+      game_play_sample(game, 5 + move_sound_idx, sound_speed, ALLEGRO_PLAYMODE_ONCE);
       move_sound_idx = (move_sound_idx + 1) % 4;
     }
-
-    for (int i = 0; i < game->num_enemies_alive; i++) {
-      if (mart_get_num_shots(game->enemy[i]) > 0) {
-        if (mart_move_bullet(game->enemy[i], MART_BULLET_SPEED) == ERROR) {
-          return ERROR;
-        }
-      }
-    }
   }
 
   return OK;
 }
 
 /**
- * @brief Checks for collisions between all game elements.
+ * @brief Awards points and the extra life once its score threshold is reached.
  *
- * Detects and handles collisions between bullets and martians, as well as
- * collisions between the player's ship and martian bullets.
+ * @param game Pointer to the GAME instance.
+ * @param points Points to add to the total score.
+ */
+static void game_add_score(GAME *game, int points) {
+  game->sim.total_score += points;
+
+  // Extra life at score threshold
+  if (!game->sim.extra_life_1500_awarded && game->sim.total_score >= EXTRA_LIFE_SCORE) {
+    ship_set_life(game->ship, ship_get_life(game->ship) + 1);
+    game->sim.extra_life_1500_awarded = true;
+    game_play_sample(game, 1, 1.5, ALLEGRO_PLAYMODE_ONCE);
+  }
+}
+
+/**
+ * @brief Spawns a short-lived explosion at (x, y).
  *
  * @param game Pointer to the GAME instance.
- * @return OK if successful, ERROR if game is NULL.
+ * @param x X-coordinate of the explosion.
+ * @param y Y-coordinate of the explosion.
  */
-STATUS game_colisions(GAME *game) {
-  if (!game)
-    return ERROR;
+static void game_add_explosion(GAME *game, FIXED x, FIXED y) {
+  OBJECT *exp = obj_create(SPRITE_EXPLOSION, x, y, true);
 
-  // 1. Player bullets
-  for (int i = ship_get_num_shots(game->ship) - 1; i >= 0; i--) {
-    BULLET *sb = ship_get_bullet_at(game->ship, i);
-    bool destroyed = false;
+  if (exp) {
+    obj_set_timer(exp, OBJECT_TIMER);
+    game_add_object(game, exp);
+  }
+}
 
-    // Contra Marcianos
-    for (int j = 0; j < game->num_enemies_alive; j++) {
-      MARTIAN *m = game->enemy[j];
+/**
+ * @brief Keeps a candidate hit if the bullet met it before the current best.
+ *
+ * Ties keep the current best, so candidates are offered in priority order.
+ *
+ * @param best Earliest hit found so far.
+ * @param kind Kind of the candidate.
+ * @param index Index of the candidate.
+ * @param distance Distance travelled before touching the candidate.
+ */
+static void game_offer_hit(HIT *best, HIT_KIND kind, int index, FIXED distance) {
+  if (distance < best->distance) {
+    best->kind = kind;
+    best->index = index;
+    best->distance = distance;
+  }
+}
 
-      if (bullet_check_collision(sb, mart_get_x(m), mart_get_y(m), MART_WIDTH, MART_HEIGHT)) {
+/**
+ * @brief First bunker row with solid pixels met by a bullet during its last move.
+ *
+ * @param bunker Bunker to test.
+ * @param bullet Bullet to test.
+ * @return Row relative to the bunker top, or -1 if the bullet met no solid pixel.
+ */
+static int game_bunker_hit_row(BUNKER *bunker, BULLET *bullet) {
+  return bunker_hit_row(bunker, bullet_x(bullet), bullet_sweep_y(bullet), bullet_width(bullet),
+                        bullet_sweep_height(bullet), bullet_y(bullet) < bullet_prev_y(bullet));
+}
 
-        al_play_sample(game->samples[1], 1.0, 0.0, 1.0, ALLEGRO_PLAYMODE_ONCE, NULL);
+/**
+ * @brief Offers every bunker whose mask has solid pixels in the bullet's sweep.
+ *
+ * The bunker boxes only preselect; the distance is that of the first
+ * solid row the bullet met.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param best Earliest hit found so far.
+ * @param bullet Bullet being tested.
+ * @param boxes Candidate boxes, in ascending ID order.
+ * @param mask Hit mask returned by aabb_overlap_mask() for boxes.
+ */
+static void game_offer_bunkers(GAME *game, HIT *best, BULLET *bullet, const AABB_SET *boxes,
+                               uint64_t mask) {
+  while (mask) {
+    int k = aabb_first_bit(mask);
 
-        for (int k = mart_get_num_shots(m) - 1; k >= 0; k--) {
-          game_add_orphan_bullet(game, mart_extract_bullet_at(m, k));
-        }
+    if (boxes->id[k] >= GRID_ID_BULLET(0))
+      break;
 
-        game->total_score += mart_get_score(m);
+    int j = boxes->id[k] - GRID_ID_BUNKER(0);
+    int r = game_bunker_hit_row(game->bunkers[j], bullet);
 
-        // Extra life at score threshold
-        if (!game->extra_life_1500_awarded && game->total_score >= EXTRA_LIFE_SCORE) {
-          ship_set_life(game->ship, ship_get_life(game->ship) + 1);
-          game->extra_life_1500_awarded = true;
-          al_play_sample(game->samples[1], 1.0, 0.0, 1.5, ALLEGRO_PLAYMODE_ONCE, NULL);
-        }
+    if (r >= 0) {
+      FIXED top = bunker_y(game->bunkers[j]) + INT_TO_FIXED(r);
+      game_offer_hit(best, HIT_BUNKER, j, bullet_entry_distance(bullet, top, top + FIXED_ONE));
+    }
 
-        // Explosion (martian)
-        OBJECT *exp = obj_create(game->martian_explosion_img, 0, 0, EXPLOSION_WIDTH, EXPLOSION_HEIGHT, mart_get_x(m), mart_get_y(m), true);
+    mask &= mask - 1;
+  }
+}
 
-        if (exp) {
-          obj_set_timer(exp, OBJECT_TIMER);
-          game_add_object(game, exp);
-        }
+/**
+ * @brief Packs the boxes of the live entities behind a list of grid IDs.
+ *
+ * Entities destroyed earlier in the collision pass are skipped, so the
+ * packed boxes always reflect the current state. Bullets are packed with
+ * the area swept by their last move.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param ids Grid IDs, in ascending order.
+ * @param n Number of IDs.
+ * @param boxes Output set; its IDs keep the order of ids.
+ */
+static void game_pack_boxes(GAME *game, const int *ids, int n, AABB_SET *boxes) {
+  aabb_set_clear(boxes);
 
-        bullet_destroy(ship_extract_bullet_at(game->ship, i));
-        game_destroy_martian(game, j);
-        destroyed = true;
-        break;
-      }
+  for (int k = 0; k < n; k++) {
+    int id = ids[k];
+
+    if (id < GRID_ID_BULLET(0)) {
+      BUNKER *bunker = game->bunkers[id - GRID_ID_BUNKER(0)];
+
+      if (bunker)
+        aabb_set_add(boxes, id, bunker_x(bunker), bunker_y(bunker), BUNKER_WIDTH, BUNKER_HEIGHT);
+    } else {
+      BULLET *bullet = slotmap_at(game->bullets, id - GRID_ID_BULLET(0));
+
+      if (bullet)
+        aabb_set_add(boxes, id, bullet_x(bullet), bullet_sweep_y(bullet), bullet_width(bullet),
+                     bullet_sweep_height(bullet));
     }
+  }
+}
 
-    if (destroyed)
-      continue;
+/**
+ * @brief Finds the first target met by a player bullet during its last move.
+ *
+ * Martians are found from the formation pitch (form_hit_test), which costs
+ * the same whatever the size of the formation. Martian bullets and bunkers
+ * come from the batched test of the grid candidates. On equal
+ * distances, martians win over bullets, the UFO and bunkers, in that order.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param sb Player bullet.
+ * @param boxes Boxes near the bullet.
+ * @param mask Boxes the bullet's sweep overlaps.
+ * @return The earliest hit, of kind HIT_NONE if there is none.
+ */
+static HIT game_ship_bullet_hit(GAME *game, BULLET *sb, const AABB_SET *boxes, uint64_t mask) {
+  HIT best = {HIT_NONE, -1, FIXED_MAX};
+  int j = form_hit_test(game->formation, bullet_x(sb), bullet_sweep_y(sb), bullet_width(sb),
+                        bullet_sweep_height(sb));
+
+  if (j >= 0) {
+    FIXED my = form_cell_y(game->formation, j);
+    game_offer_hit(&best, HIT_MARTIAN, j,
+                   bullet_entry_distance(sb, my, my + INT_TO_FIXED(MART_HEIGHT)));
+  }
 
-    // Contra Balas Enemigas (unificadas)
-    for (int j = 0; j < game->num_enemies_alive; j++) {
-      MARTIAN *m = game->enemy[j];
+  // Both bullets moved: the boxes only preselect, the exact test uses their relative motion
+  for (uint64_t m = mask; m; m &= m - 1) {
+    int k = aabb_first_bit(m);
+    FIXED distance;
 
-      for (int k = mart_get_num_shots(m) - 1; k >= 0; k--) {
-        BULLET *mb = mart_get_bullet_at(m, k);
+    if (boxes->id[k] >= GRID_ID_BULLET(0) &&
+        bullet_meets(sb, slotmap_at(game->bullets, boxes->id[k] - GRID_ID_BULLET(0)), &distance))
+      game_offer_hit(&best, HIT_BULLET, boxes->id[k] - GRID_ID_BULLET(0), distance);
+  }
 
-        if (bullet_check_collision(sb, bullet_get_x(mb), bullet_get_y(mb),
-                                  bullet_get_width(mb),
-                                  bullet_get_height(mb))) {
+  if (game->ufo && bullet_sweep_overlaps(sb, obj_get_x(game->ufo), obj_get_y(game->ufo),
+                                         UFO_WIDTH, UFO_HEIGHT)) {
+    FIXED uy = obj_get_y(game->ufo);
+    game_offer_hit(&best, HIT_UFO, 0,
+                   bullet_entry_distance(sb, uy, uy + INT_TO_FIXED(UFO_HEIGHT)));
+  }
 
-          // Bullet collision explosion
-          OBJECT *exp = obj_create(game->martian_explosion_img, 0, 0,
-                                   EXPLOSION_WIDTH, EXPLOSION_HEIGHT,
-                                   bullet_get_x(mb), bullet_get_y(mb), true);
-          if (exp) {
-            obj_set_timer(exp, OBJECT_TIMER);
-            game_add_object(game, exp);
-          }
+  game_offer_bunkers(game, &best, sb, boxes, mask);
 
-          bullet_destroy(ship_extract_bullet_at(game->ship, i));
-          bullet_destroy(mart_extract_bullet_at(m, k));
-          destroyed = true;
-          break;
-        }
-      }
+  return best;
+}
 
-      if (destroyed)
-        break;
-    }
+/**
+ * @brief Finds the first target met by a martian bullet during its last move.
+ *
+ * On equal distances the ship wins over bunkers.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param bullet Martian bullet.
+ * @param boxes Boxes near the bullet.
+ * @param mask Boxes the bullet's sweep overlaps.
+ * @return The earliest hit, of kind HIT_NONE if there is none.
+ */
+static HIT game_martian_bullet_hit(GAME *game, BULLET *bullet, const AABB_SET *boxes,
+                                   uint64_t mask) {
+  HIT best = {HIT_NONE, -1, FIXED_MAX};
+
+  if (GOD_MODE == 0 && !game->sim.ship_exploding &&
+      bullet_sweep_overlaps(bullet, ship_get_x(game->ship), ship_get_y(game->ship),
+                            ship_get_width(game->ship), ship_get_height(game->ship))) {
+    FIXED sy = ship_get_y(game->ship);
+    FIXED sb = sy + INT_TO_FIXED(ship_get_height(game->ship));
+    game_offer_hit(&best, HIT_SHIP, 0, bullet_entry_distance(bullet, sy, sb));
+  }
+
+  game_offer_bunkers(game, &best, bullet, boxes, mask);
+
+  return best;
+}
+
+/**
+ * @brief Rebuilds the collision grid from the current positions.
+ *
+ * Bunkers and martian bullets are inserted, the bullets with the area
+ * swept by their last move. Player bullets are never a query target, and
+ * martians are looked up through the formation.
+ *
+ * @param game Pointer to the GAME instance.
+ */
+static void game_build_grid(GAME *game) {
+  grid_clear(game->grid);
 
-    if (destroyed)
-      continue;
+  for (int j = 0; j < NUM_BUNKERS; j++) {
+    if (game->bunkers[j])
+      grid_insert(game->grid, GRID_ID_BUNKER(j), bunker_x(game->bunkers[j]),
+                  bunker_y(game->bunkers[j]), BUNKER_WIDTH, BUNKER_HEIGHT);
+  }
 
-    for (int j = game->num_orphan_bullets - 1; j >= 0; j--) {
-      BULLET *ob = game->orphan_bullets[j];
+  for (int i = 0; i < slotmap_count(game->bullets); i++) {
+    BULLET *bullet = slotmap_at(game->bullets, i);
 
-      if (bullet_check_collision(sb, bullet_get_x(ob), bullet_get_y(ob),
-                                bullet_get_width(ob), bullet_get_height(ob))) {
+    if (bullet && bullet_owner(bullet) == BULLET_MARTIAN)
+      grid_insert(game->grid, GRID_ID_BULLET(i), bullet_x(bullet), bullet_sweep_y(bullet),
+                  bullet_width(bullet), bullet_sweep_height(bullet));
+  }
+}
 
-        OBJECT *exp = obj_create(game->martian_explosion_img, 0, 0,
-                                 EXPLOSION_WIDTH, EXPLOSION_HEIGHT,
-                                 bullet_get_x(ob), bullet_get_y(ob), true);
-        if (exp) {
-          obj_set_timer(exp, OBJECT_TIMER);
-          game_add_object(game, exp);
-        }
+/**
+ * @brief Finds the first target met by a bullet during its last move.
+ *
+ * Reads the game state only, so the whole detection pass is free of side
+ * effects. The bullet's sweep is looked up in the collision grid and the
+ * candidates are packed and tested in one batched call.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param bullet Bullet to test.
+ * @return The earliest hit, of kind HIT_NONE if there is none.
+ */
+static HIT game_detect_hit(GAME *game, BULLET *bullet) {
+  int ids[AABB_MAX_BOXES]; // A query covers a few cells, far below this
+  AABB_SET boxes;
+  uint64_t mask;
+  int n;
+
+  n = grid_query(game->grid, bullet_x(bullet), bullet_sweep_y(bullet), bullet_width(bullet),
+                 bullet_sweep_height(bullet), ids, AABB_MAX_BOXES);
+  game_pack_boxes(game, ids, n, &boxes);
+  mask = aabb_overlap_mask(&boxes, bullet_x(bullet), bullet_sweep_y(bullet),
+                           bullet_width(bullet), bullet_sweep_height(bullet));
+
+  if (bullet_owner(bullet) == BULLET_SHIP) {
+    // 1. Player bullets vs martians, martian bullets, UFO and bunkers
+    return game_ship_bullet_hit(game, bullet, &boxes, mask);
+  }
 
-        bullet_destroy(ship_extract_bullet_at(game->ship, i));
-        bullet_destroy(game_extract_orphan_bullet_at(game, j));
-        destroyed = true;
-        break;
-      }
-    }
+  // 2. Martian bullets vs Player and Bunkers
+  return game_martian_bullet_hit(game, bullet, &boxes, mask);
+}
 
-    if (destroyed)
-      continue;
+/**
+ * @brief Whether the target of a hit can still be hit.
+ *
+ * A bunker is still there if solid pixels are left in the bullet's sweep.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param bullet Bullet that hit.
+ * @param kind Kind of the target.
+ * @param index Index of the target.
+ * @return true if the target is still there, false if an earlier hit removed it.
+ */
+static bool game_hit_target_alive(GAME *game, BULLET *bullet, HIT_KIND kind, int index) {
+  switch (kind) {
+  case HIT_MARTIAN:
+    return form_cell_alive(game->formation, index);
+  case HIT_BULLET:
+    return slotmap_at(game->bullets, index) != NULL;
+  case HIT_UFO:
+    return game->ufo != NULL;
+  case HIT_BUNKER:
+    return game->bunkers[index] && game_bunker_hit_row(game->bunkers[index], bullet) >= 0;
+  case HIT_SHIP:
+    return !game->sim.ship_exploding;
+  default:
+    return false;
+  }
+}
 
-    // Contra UFO
-    if (game->ufo && bullet_check_collision(sb, obj_get_x(game->ufo), obj_get_y(game->ufo),
-              UFO_WIDTH, UFO_HEIGHT)) {
+/**
+ * @brief Removes or damages the target of a hit and records where it was.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param event Hit to apply; its position is filled in.
+ */
+static void game_damage_target(GAME *game, HIT_EVENT *event) {
+  int j = event->index;
+
+  switch ((HIT_KIND)event->kind) {
+  case HIT_MARTIAN:
+    event->x = form_cell_x(game->formation, j);
+    event->y = form_cell_y(game->formation, j);
+    game_destroy_martian(game, j);
+    break;
+
+  case HIT_BULLET: {
+    BULLET *mb = slotmap_at(game->bullets, j);
+
+    event->x = bullet_x(mb);
+    event->y = bullet_y(mb);
+    game_kill_bullet_at(game, j);
+    break;
+  }
 
-      // Original arcade UFO scores: 50, 100, 150, or 300
-      static const int ufo_scores[] = {50, 100, 150, 300};
-      game->total_score += ufo_scores[rand() % 4];
+  case HIT_UFO:
+    event->x = obj_get_x(game->ufo);
+    event->y = obj_get_y(game->ufo);
+    obj_destroy(game->ufo);
+    game->ufo = NULL;
+    break;
 
-      // Extra life at score threshold
-      if (!game->extra_life_1500_awarded && game->total_score >= EXTRA_LIFE_SCORE) {
-        ship_set_life(game->ship, ship_get_life(game->ship) + 1);
-        game->extra_life_1500_awarded = true;
-        al_play_sample(game->samples[1], 1.0, 0.0, 1.5, ALLEGRO_PLAYMODE_ONCE, NULL);
-      }
+  case HIT_BUNKER: {
+    // Blasts a hole centred on the bullet, at the first solid row it met
+    BULLET *bullet = slotmap_at(game->bullets, event->bullet);
+    int r = game_bunker_hit_row(game->bunkers[j], bullet);
 
-      al_stop_samples();
-      al_play_sample(game->samples[4], 1.0, 0.0, 1.0, ALLEGRO_PLAYMODE_ONCE, NULL);
+    event->x = bullet_x(bullet) + INT_TO_FIXED(bullet_width(bullet)) / 2;
+    event->y = bunker_y(game->bunkers[j]) + INT_TO_FIXED(r);
+    bunker_erode(game->bunkers[j], event->x, event->y);
+    break;
+  }
 
-      // Explosion UFO
-      OBJECT *exp = obj_create(game->martian_explosion_img, 0, 0, 
-                               EXPLOSION_WIDTH, EXPLOSION_HEIGHT, obj_get_x(game->ufo), 
-                               obj_get_y(game->ufo), true);
+  case HIT_SHIP:
+    // Starts the ship explosion (freezing gameplay) and costs one life
+    event->x = ship_get_x(game->ship);
+    event->y = ship_get_y(game->ship);
+    game->sim.ship_exploding = true;
+    game->sim.ship_explosion_timer = SHIP_EXPLOSION_FRAMES;
+    ship_decrease_life(game->ship, 1);
+    break;
+
+  default:
+    break;
+  }
+}
 
-      if (exp) {
-        obj_set_timer(exp, OBJECT_TIMER);
-        game_add_object(game, exp);
-      }
+/**
+ * @brief Applies the recorded hits to the entities, in bullet order.
+ *
+ * Detection ran on the state at the start of the tick, so an earlier hit
+ * may have removed a bullet or target a later record refers to. A record
+ * whose bullet is gone is dropped. A record whose target is gone is
+ * detected again on the current state. This gives the same outcome as
+ * testing and applying each bullet in turn. Dropped records are removed
+ * from the buffer, so the passes after this one see confirmed hits only.
+ *
+ * @param game Pointer to the GAME instance.
+ */
+static void game_resolve_hits(GAME *game) {
+  int kept = 0;
 
-      bullet_destroy(ship_extract_bullet_at(game->ship, i));
-      obj_destroy(game->ufo);
-      game->ufo = NULL;
+  for (int k = 0; k < game->num_hits; k++) {
+    HIT_EVENT event = game->hits[k];
+    BULLET *bullet = slotmap_at(game->bullets, event.bullet);
 
+    if (!bullet)
       continue;
-    }
 
-    // Contra Bunkers (Cualquiera de las partes)
-    for (int j = 0; j < NUM_BUNKERS * BUNKER_PARTS; j++) {
-      if (!game->bunkers[j])
+    if (!game_hit_target_alive(game, bullet, (HIT_KIND)event.kind, event.index)) {
+      HIT hit = game_detect_hit(game, bullet);
+
+      if (hit.kind == HIT_NONE)
         continue;
 
-      if (bullet_check_collision(sb, bunker_get_x(game->bunkers[j]),
-                                bunker_get_y(game->bunkers[j]), BUNKER_PART_WIDTH,
-                                BUNKER_PART_HEIGHT)) {
+      event.kind = hit.kind;
+      event.index = hit.index;
+    }
 
-        int life = bunker_get_life(game->bunkers[j]) - 1;
-        bunker_set_life(game->bunkers[j], life);
-        bunker_set_source_x(game->bunkers[j], (BUNKER_LIFE - life)); // 1 state per hit
-        bullet_destroy(ship_extract_bullet_at(game->ship, i));
+    game_damage_target(game, &event);
+    game_kill_bullet_at(game, event.bullet);
+    game->hits[kept++] = event;
+  }
 
-        if (life <= 0) {
-          bunker_destroy(game->bunkers[j]);
-          game->bunkers[j] = NULL;
-        }
+  game->num_hits = kept;
+}
 
-        destroyed = true;
-        break;
-      }
+/**
+ * @brief Adds the points of the martians and UFO hit this tick.
+ *
+ * @param game Pointer to the GAME instance.
+ */
+static void game_score_hits(GAME *game) {
+  // Original arcade UFO scores: 50, 100, 150, or 300
+  static const int ufo_scores[] = {50, 100, 150, 300};
+
+  for (int k = 0; k < game->num_hits; k++) {
+    if (game->hits[k].kind == HIT_MARTIAN) {
+      game_add_score(game, form_get_cell_score(game->formation, game->hits[k].index));
+    } else if (game->hits[k].kind == HIT_UFO) {
+      game_add_score(game, ufo_scores[game_rand(game) % 4]);
     }
   }
+}
 
-  // 2. Martian bullets vs Player and Bunkers
-  for (int j = 0; j < game->num_enemies_alive; j++) {
-    MARTIAN *m = game->enemy[j];
-
-    for (int k = mart_get_num_shots(m) - 1; k >= 0; k--) {
-      BULLET *mb = mart_get_bullet_at(m, k);
-
-      if (GOD_MODE == 0 && !game->ship_exploding && 
-          bullet_check_collision(mb, ship_get_x(game->ship), 
-          ship_get_y(game->ship), ship_get_width(game->ship), 
-          ship_get_height(game->ship))) {
-       
-        al_play_sample(game->samples[2], 1.0, 0.0, 1.0, ALLEGRO_PLAYMODE_ONCE, NULL);
-        // Start ship explosion animation (freezing gameplay)
-        game->ship_exploding = true;
-        game->ship_explosion_timer = SHIP_EXPLOSION_FRAMES;
-
-        bullet_destroy(mart_extract_bullet_at(m, k));
-        ship_decrease_life(game->ship, 1);
-        continue;
-      }
-
-      for (int l = 0; l < NUM_BUNKERS * BUNKER_PARTS; l++) {
-        if (!game->bunkers[l])
-          continue;
-
-        if (bullet_check_collision(mb, bunker_get_x(game->bunkers[l]),
-                                  bunker_get_y(game->bunkers[l]),
-                                  BUNKER_PART_WIDTH, BUNKER_PART_HEIGHT)) {
-
-          int life = bunker_get_life(game->bunkers[l]) - 1;
-          bunker_set_life(game->bunkers[l], life);
-          bunker_set_source_x(game->bunkers[l], (BUNKER_LIFE - life));
-          bullet_destroy(mart_extract_bullet_at(m, k));
+/**
+ * @brief Spawns the explosions of the martians, bullets and UFO hit this tick.
+ *
+ * @param game Pointer to the GAME instance.
+ */
+static void game_spawn_hit_effects(GAME *game) {
+  for (int k = 0; k < game->num_hits; k++) {
+    HIT_KIND kind = (HIT_KIND)game->hits[k].kind;
 
-          if (life <= 0) {
-            bunker_destroy(game->bunkers[l]);
-            game->bunkers[l] = NULL;
-          }
-          break;
-        }
-      }
+    if (kind == HIT_MARTIAN || kind == HIT_BULLET || kind == HIT_UFO) {
+      game_add_explosion(game, game->hits[k].x, game->hits[k].y);
     }
   }
+}
 
-  // Same for orphan bullets
-  for (int i = game->num_orphan_bullets - 1; i >= 0; i--) {
-    BULLET *ob = game->orphan_bullets[i];
+/**
+ * @brief Plays the sounds of the hits of this tick.
+ *
+ * @param game Pointer to the GAME instance.
+ */
+static void game_play_hit_sounds(GAME *game) {
+  for (int k = 0; k < game->num_hits; k++) {
+    switch ((HIT_KIND)game->hits[k].kind) {
+    case HIT_MARTIAN:
+      game_play_sample(game, 1, 1.0, ALLEGRO_PLAYMODE_ONCE);
+      break;
+    case HIT_UFO:
+      game_stop_samples(game); // Ends the UFO loop
+      game_play_sample(game, 4, 1.0, ALLEGRO_PLAYMODE_ONCE);
+      break;
+    case HIT_SHIP:
+      game_play_sample(game, 2, 1.0, ALLEGRO_PLAYMODE_ONCE);
+      break;
+    default:
+      break;
+    }
+  }
+}
 
-    if (GOD_MODE == 0 && !game->ship_exploding && 
-        bullet_check_collision(ob, ship_get_x(game->ship), 
-        ship_get_y(game->ship), ship_get_width(game->ship), 
-        ship_get_height(game->ship))) {
+/**
+ * @brief Clears the bunker pixels overlapped by live martians.
+ *
+ * Only does work once the formation has descended to the bunkers. Erasing
+ * the same pixels again changes nothing.
+ *
+ * @param game Pointer to the GAME instance.
+ */
+static void game_martians_erase_bunkers(GAME *game) {
+  if (form_get_bottom(game->formation) + INT_TO_FIXED(MART_HEIGHT) <= INT_TO_FIXED(BUNKER_INIT_POS_Y))
+    return;
 
-      al_play_sample(game->samples[2], 1.0, 0.0, 1.0, ALLEGRO_PLAYMODE_ONCE, NULL);
+  for (int i = 0; i < form_get_size(game->formation); i++) {
+    if (!form_cell_alive(game->formation, i)) continue;
 
-      game->ship_exploding = true;
-      game->ship_explosion_timer = SHIP_EXPLOSION_FRAMES;
+    for (int j = 0; j < NUM_BUNKERS; j++) {
+      bunker_erase(game->bunkers[j], form_cell_x(game->formation, i),
+                   form_cell_y(game->formation, i), MART_WIDTH, MART_HEIGHT);
+    }
+  }
+}
 
-      bullet_destroy(game_extract_orphan_bullet_at(game, i));
-      ship_decrease_life(game->ship, 1);
+/**
+ * @brief Takes the bullets due for a collision test this tick off the schedule.
+ *
+ * Entries of bullets that are gone are dropped. The bullets are returned
+ * in packed array order, so hits are applied in the same order as when
+ * every bullet was tested.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param due Output handles of the due bullets (MAX_BULLETS entries).
+ * @return Number of handles written to due.
+ */
+static int game_pop_due_bullets(GAME *game, SLOT_HANDLE *due) {
+  int index[MAX_BULLETS];
+  int n = 0;
+
+  while (!bullet_schedule_is_empty(&game->schedule) &&
+         bullet_schedule_top(&game->schedule)->tick <= game->sim.bullet_tick) {
+    BULLET_DUE entry;
+    int i;
+
+    bullet_schedule_pop(&game->schedule, &entry);
+    i = slotmap_index_of(game->bullets, entry.bullet);
+    if (i < 0 || n >= MAX_BULLETS)
       continue;
+
+    // Insertion sort by packed position: few bullets are due at once
+    int k = n++;
+    while (k > 0 && index[k - 1] > i) {
+      index[k] = index[k - 1];
+      due[k] = due[k - 1];
+      k--;
     }
+    index[k] = i;
+    due[k] = entry.bullet;
+  }
 
-    for (int l = 0; l < NUM_BUNKERS * BUNKER_PARTS; l++) {
-      if (!game->bunkers[l])
-        continue;
+  return n;
+}
+
+/**
+ * @brief Checks for collisions between all game elements.
+ *
+ * Detects and handles collisions between bullets and martians, as well as
+ * collisions between the player's ship and martian bullets.
+ *
+ * Only the bullets due in the impact schedule are tested: player bullets
+ * every tick, martian bullets from the first tick they can reach a bunker
+ * or the ship's row. Martian bullets still in flight are tested as targets
+ * of the player bullets.
+ *
+ * Each bullet is tested with the whole area it swept during its last
+ * move, not only its current box, so a bullet moving more than a target's
+ * height in one tick cannot jump over it. Of all the targets on its path,
+ * the bullet hits the one it met first. Bunkers and martian bullets
+ * are only tested when the collision grid finds them in the bullet's
+ * cells; their boxes are packed and tested in one batched call.
+ *
+ * Detection only reads the state and appends one record per hit to the
+ * tick's hit buffer. The records are then applied in separate passes:
+ * damage, score, explosions and sounds. Bullets destroyed while applying
+ * hits only leave an empty slot behind, so indexes stay stable; the slots
+ * are compacted once damage is done.
+ *
+ * @param game Pointer to the GAME instance.
+ * @return OK if successful, ERROR if game is NULL.
+ */
+STATUS game_colisions(GAME *game) {
+  if (!game)
+    return ERROR;
 
-      if (bullet_check_collision(ob, bunker_get_x(game->bunkers[l]),
-                                bunker_get_y(game->bunkers[l]), BUNKER_PART_WIDTH,
-                                BUNKER_PART_HEIGHT)) {
+  SLOT_HANDLE due[MAX_BULLETS];
+  int n = game_pop_due_bullets(game, due);
 
-        int life = bunker_get_life(game->bunkers[l]) - 1;
-        bunker_set_life(game->bunkers[l], life);
-        bunker_set_source_x(game->bunkers[l], (BUNKER_LIFE - life));
-        bullet_destroy(game_extract_orphan_bullet_at(game, i));
+  game_build_grid(game);
+  game->num_hits = 0;
 
-        if (life <= 0) {
-          bunker_destroy(game->bunkers[l]);
-          game->bunkers[l] = NULL;
-        }
-        break;
-      }
+  for (int k = 0; k < n; k++) {
+    int i = slotmap_index_of(game->bullets, due[k]);
+    HIT hit = game_detect_hit(game, slotmap_at(game->bullets, i));
+
+    if (hit.kind != HIT_NONE) {
+      HIT_EVENT event = {(uint8_t)hit.kind, (int16_t)i, (int16_t)hit.index, 0, 0};
+      game->hits[game->num_hits++] = event;
     }
   }
 
-  // 3. Martians destroy bunkers on overlap (when descending)
-  for (int i = 0; i < game->num_enemies_alive && game->enemy[i] != NULL; i++) {
-    int mx = mart_get_x(game->enemy[i]);
-    int my = mart_get_y(game->enemy[i]);
+  game_resolve_hits(game);
+  game_compact_bullets(game);
 
-    for (int j = 0; j < NUM_BUNKERS * BUNKER_PARTS; j++) {
-      if (!game->bunkers[j]) continue;
+  // Bullets that survived their test wait for their next due tick
+  for (int k = 0; k < n; k++) {
+    if (slotmap_get(game->bullets, due[k]))
+      game_schedule_bullet(game, due[k], game->sim.bullet_tick + 1);
+  }
 
-      float bx = bunker_get_x(game->bunkers[j]);
-      float by = bunker_get_y(game->bunkers[j]);
+  game_score_hits(game);
+  game_spawn_hit_effects(game);
+  game_play_hit_sounds(game);
 
-      if (mx < bx + BUNKER_PART_WIDTH && mx + MART_WIDTH > bx &&
-          my < by + BUNKER_PART_HEIGHT && my + MART_HEIGHT > by) {
-        bunker_destroy(game->bunkers[j]);
-        game->bunkers[j] = NULL;
-      }
-    }
-  }
+  // 3. Martians wipe out the bunker pixels they overlap (when descending)
+  game_martians_erase_bunkers(game);
 
   return OK;
 }
@@ -1694,35 +2836,22 @@ STATUS game_animations_update(GAME *game) {
   }
 
   // Enemy animation timer
-  if (++game->enemy_animation_timer > MART_ANIMATION_SPEED) {
-
-    // Animate enemies
-    for (int i = 0; i < game->num_enemies_alive; i++) { 
-      if (mart_get_source_x(game->enemy[i]) > 0) {
-        mart_set_source_x(game->enemy[i], 0);
-      } else {
-        // Second tile frame to simulate movement
-        mart_set_source_x(game->enemy[i], 1); 
-      }
-
-      // Animate enemy bullets
-      if (mart_get_num_shots(game->enemy[i]) > 0) { 
-        for (int j = 0; j < mart_get_num_shots(game->enemy[i]); j++) {
-          BULLET *bullet = mart_get_bullet_at(game->enemy[i], j);
+  if (++game->sim.enemy_animation_timer > MART_ANIMATION_SPEED) {
 
-          if (bullet_get_source_x(bullet) > 0) {
-            bullet_set_source_x(bullet, 0);
-          } else {
-            // Second tile frame to simulate movement
-            bullet_set_source_x(bullet, 1); 
-          }
-        }
-      }
+    // Animate enemies (the whole formation shares one frame)
+    if (form_get_source_x(game->formation) > 0) {
+      form_set_source_x(game->formation, 0);
+    } else {
+      // Second tile frame to simulate movement
+      form_set_source_x(game->formation, 1);
     }
 
-    // Animate orphan bullets
-    for (int i = 0; i < game->num_orphan_bullets; i++) { 
-      BULLET *bullet = game_get_orphan_bullet_at(game, i);
+    // Animate enemy bullets
+    for (int i = 0; i < slotmap_count(game->bullets); i++) {
+      BULLET *bullet = slotmap_at(game->bullets, i);
+
+      if (bullet_owner(bullet) != BULLET_MARTIAN)
+        continue;
 
       if (bullet_get_source_x(bullet) > 0) {
         bullet_set_source_x(bullet, 0);
@@ -1732,7 +2861,7 @@ STATUS game_animations_update(GAME *game) {
       }
     }
 
-    game->enemy_animation_timer = 0;
+    game->sim.enemy_animation_timer = 0;
   }
 
   return OK;
@@ -1745,51 +2874,51 @@ STATUS game_animations_update(GAME *game) {
  * and animations each frame.
  *
  * @param game Pointer to the GAME instance.
- * @param key Pointer to the keyboard state.
+ * @param input Player input of the tick.
  * @return OK if update is successful, ERROR if game is NULL.
  */
-STATUS game_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key) {
-  float current_mart_speed;
+STATUS game_update(GAME *game, const GAME_INPUT *input) {
+  FIXED current_mart_speed;
 
   if (!game) {
     return ERROR;
   }
 
   // Constant step speed: perceived speed comes from dynamic timer in game_martians_update
-  current_mart_speed = MART_BASE_SPEED;
+  current_mart_speed = INT_TO_FIXED(MART_BASE_SPEED);
 
-  switch (game->events.type) {
+  switch (game->media.events.type) {
     case (ALLEGRO_EVENT_DISPLAY_CLOSE):
-      game->done = true;
+      game->sim.done = true;
       break;
 
     case (ALLEGRO_EVENT_TIMER):
       // TITLE SCREEN
-      if (game->state == STATE_TITLE) {
-        game->title_timer++;
+      if (game->sim.state == STATE_TITLE) {
+        game->sim.title_timer++;
 
         // Slow enemy animation on title screen
-        if (game->title_timer % 4 == 0) {
+        if (game->sim.title_timer % 4 == 0) {
           game_animations_update(game);
         }
         // Slow enemy movement on title screen
-        if (game->title_timer % 15 == 0) {
-          game_move_martians(game, 2);
+        if (game->sim.title_timer % 15 == 0) {
+          game_move_martians(game, INT_TO_FIXED(2));
         }
 
-        if (al_key_down(key, ALLEGRO_KEY_ENTER)) {
-          game->state = STATE_PLAYING;
-          game->extra_life_1500_awarded = false;
-          game->level_start_delay = 45;
-          game->title_timer = 0;
+        if (input->enter) {
+          game->sim.state = STATE_PLAYING;
+          game->sim.extra_life_1500_awarded = false;
+          game->sim.level_start_delay = 45;
+          game->sim.title_timer = 0;
         }
 
-        game->draw = true;
+        game->sim.draw = true;
         break;
       }
 
       // HIGHSCORE ENTRY STATE
-      if (game->state == STATE_HIGHSCORE_ENTRY) {
+      if (game->sim.state == STATE_HIGHSCORE_ENTRY) {
         static bool enter_held = false;
         static bool up_held = false;
         static bool down_held = false;
@@ -1797,22 +2926,22 @@ STATUS game_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key) {
         static bool left_held = false;
 
         // Input delay prevents Enter bleed from GAME_OVER screen
-        if (game->highscore_entry_delay > 0) {
-          game->highscore_entry_delay--;
-          if (game->highscore_entry_delay == 0) {
+        if (game->ui.highscore_entry_delay > 0) {
+          game->ui.highscore_entry_delay--;
+          if (game->ui.highscore_entry_delay == 0) {
             enter_held = up_held = down_held = right_held = left_held = true;
           }
         } else {
-          if (++game->highscore_entry_cursor_timer >= 8) {
-            game->highscore_entry_cursor_timer = 0;
+          if (++game->ui.highscore_entry_cursor_timer >= 8) {
+            game->ui.highscore_entry_cursor_timer = 0;
           }
 
           // UP: cycle letter forward at cursor position
-          if (al_key_down(key, ALLEGRO_KEY_UP)) {
+          if (input->up) {
             if (!up_held) {
-              game->highscore_letters[game->highscore_entry_pos]++;
-              if (game->highscore_letters[game->highscore_entry_pos] > 'Z')
-                game->highscore_letters[game->highscore_entry_pos] = '0';
+              game->ui.highscore_letters[game->ui.highscore_entry_pos]++;
+              if (game->ui.highscore_letters[game->ui.highscore_entry_pos] > 'Z')
+                game->ui.highscore_letters[game->ui.highscore_entry_pos] = '0';
               up_held = true;
             }
           } else {
@@ -1820,11 +2949,11 @@ STATUS game_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key) {
           }
 
           // DOWN: cycle letter backward at cursor position
-          if (al_key_down(key, ALLEGRO_KEY_DOWN)) {
+          if (input->down) {
             if (!down_held) {
-              game->highscore_letters[game->highscore_entry_pos]--;
-              if (game->highscore_letters[game->highscore_entry_pos] < '0')
-                game->highscore_letters[game->highscore_entry_pos] = 'Z';
+              game->ui.highscore_letters[game->ui.highscore_entry_pos]--;
+              if (game->ui.highscore_letters[game->ui.highscore_entry_pos] < '0')
+                game->ui.highscore_letters[game->ui.highscore_entry_pos] = 'Z';
               down_held = true;
             }
           } else {
@@ -1832,10 +2961,10 @@ STATUS game_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key) {
           }
 
           // RIGHT: move cursor to next letter position
-          if (al_key_down(key, ALLEGRO_KEY_RIGHT)) {
+          if (input->right) {
             if (!right_held) {
-              game->highscore_entry_pos++;
-              if (game->highscore_entry_pos > 2) game->highscore_entry_pos = 2;
+              game->ui.highscore_entry_pos++;
+              if (game->ui.highscore_entry_pos > 2) game->ui.highscore_entry_pos = 2;
               right_held = true;
             }
           } else {
@@ -1843,10 +2972,10 @@ STATUS game_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key) {
           }
 
           // LEFT: move cursor to previous letter position
-          if (al_key_down(key, ALLEGRO_KEY_LEFT)) {
+          if (input->left) {
             if (!left_held) {
-              game->highscore_entry_pos--;
-              if (game->highscore_entry_pos < 0) game->highscore_entry_pos = 0;
+              game->ui.highscore_entry_pos--;
+              if (game->ui.highscore_entry_pos < 0) game->ui.highscore_entry_pos = 0;
               left_held = true;
             }
           } else {
@@ -1854,113 +2983,113 @@ STATUS game_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key) {
           }
 
           // ENTER: finish entering initials (must release key first to avoid bleed)
-          if (game->highscore_enter_needs_release) {
-            if (!al_key_down(key, ALLEGRO_KEY_ENTER)) {
-              game->highscore_enter_needs_release = false;
+          if (game->ui.highscore_enter_needs_release) {
+            if (!input->enter) {
+              game->ui.highscore_enter_needs_release = false;
               enter_held = false;
             }
-          } else if (al_key_down(key, ALLEGRO_KEY_ENTER)) {
+          } else if (input->enter) {
             if (!enter_held) {
-              game->top_scores[0].name[0] = game->highscore_letters[0];
-              game->top_scores[0].name[1] = game->highscore_letters[1];
-              game->top_scores[0].name[2] = game->highscore_letters[2];
-              game->top_scores[0].name[3] = '\0';
+              game->ui.top_scores[0].name[0] = game->ui.highscore_letters[0];
+              game->ui.top_scores[0].name[1] = game->ui.highscore_letters[1];
+              game->ui.top_scores[0].name[2] = game->ui.highscore_letters[2];
+              game->ui.top_scores[0].name[3] = '\0';
               game_save_top_scores(game);
               game_save_highscore(game);
-              game->highscore_entry_active = false;
+              game->ui.highscore_entry_active = false;
               game_full_reset(game);
-              game->draw = true;
+              game->sim.draw = true;
               break;
             }
           } else {
             enter_held = false;
           }
 
-          if (al_key_down(key, ALLEGRO_KEY_ESCAPE)) {
-            game->highscore_entry_active = false;
+          if (input->escape) {
+            game->ui.highscore_entry_active = false;
             game_full_reset(game);
-            game->draw = true;
+            game->sim.draw = true;
             break;
           }
         }
 
-        game->draw = true;
+        game->sim.draw = true;
         break;
       }
 
-      if (game->state != STATE_PLAYING) {
+      if (game->sim.state != STATE_PLAYING) {
         // GAME OVER or WIN state
-        if (al_key_down(key, ALLEGRO_KEY_ENTER)) {
-          if (game->state == STATE_WIN) {
+        if (input->enter) {
+          if (game->sim.state == STATE_WIN) {
             game_next_level(game);
           } else {
             game_save_highscore(game);
             // Check if score qualifies for highscores
-            if (game_highscore_verify(game, game->total_score)) {
-              game->highscore_entry_active = true;
-              game->highscore_entry_pos = 0;
-              memset(game->highscore_letters, 'A', 3);
-              game->highscore_score = game->total_score;
-              game->highscore_entry_cursor_timer = 0;
-              game->highscore_entry_delay = 45;
-              game->highscore_enter_needs_release = true;
-              game_insert_top_score(game, game->total_score);
-              game->state = STATE_HIGHSCORE_ENTRY;
+            if (game_highscore_verify(game, game->sim.total_score)) {
+              game->ui.highscore_entry_active = true;
+              game->ui.highscore_entry_pos = 0;
+              memset(game->ui.highscore_letters, 'A', 3);
+              game->ui.highscore_score = game->sim.total_score;
+              game->ui.highscore_entry_cursor_timer = 0;
+              game->ui.highscore_entry_delay = 45;
+              game->ui.highscore_enter_needs_release = true;
+              game_insert_top_score(game, game->sim.total_score);
+              game->sim.state = STATE_HIGHSCORE_ENTRY;
             } else {
               game_full_reset(game);
             }
           }
-        } else if (al_key_down(key, ALLEGRO_KEY_ESCAPE)) {
-          game->done = true;
+        } else if (input->escape) {
+          game->sim.done = true;
         }
-        game->draw = true;
+        game->sim.draw = true;
         break;
       }
 
       // Pause (P) with edge detection for clean toggle
       {
-        bool p_is_down = al_key_down(key, ALLEGRO_KEY_P);
-        if (p_is_down && !game->p_was_down) {
-          game->paused = !game->paused;
+        bool p_is_down = input->pause;
+        if (p_is_down && !game->sim.p_was_down) {
+          game->sim.paused = !game->sim.paused;
         }
-        game->p_was_down = p_is_down;
+        game->sim.p_was_down = p_is_down;
       }
 
-      if (game->paused) {
-        game->draw = true;
+      if (game->sim.paused) {
+        game->sim.draw = true;
         break;
       }
 
       // ESC during gameplay -> exit
-      if (al_key_down(key, ALLEGRO_KEY_ESCAPE)) {
-        game->done = true;
+      if (input->escape) {
+        game->sim.done = true;
         break;
       }
 
-      if (game->ship_exploding) {
-        game->ship_explosion_timer--;
+      if (game->sim.ship_exploding) {
+        game->sim.ship_explosion_timer--;
 
         // Alternate between explosion frames (indices 1 and 2 of bitmap)
         // Change frame every 6 ticks (~0.1s at 60FPS)
-        int frame = (game->ship_explosion_timer / 6) % 2 + 1;
+        int frame = (game->sim.ship_explosion_timer / 6) % 2 + 1;
         ship_set_source_x(game->ship, frame);
 
-        if (game->ship_explosion_timer <= 0) {
-          game->ship_exploding = false;
+        if (game->sim.ship_explosion_timer <= 0) {
+          game->sim.ship_exploding = false;
           ship_set_source_x(game->ship, 0);
 
           if (ship_get_life(game->ship) <= 0) {
-            game->state = STATE_GAME_OVER;
+            game->sim.state = STATE_GAME_OVER;
           } else {
-            ship_set_x(game->ship, SHIP_INIT_POS_X);
-            ship_set_y(game->ship, SHIP_INIT_POS_Y);
+            ship_set_x(game->ship, INT_TO_FIXED(SHIP_INIT_POS_X));
+            ship_set_y(game->ship, INT_TO_FIXED(SHIP_INIT_POS_Y));
           }
         }
-        game->draw = true;
+        game->sim.draw = true;
         break; // Freeze gameplay during explosion
       }
 
-      if (game_ship_update(game, key) == ERROR) {
+      if (game_ship_update(game, input) == ERROR) {
         return ERROR;
       }
 
@@ -1971,36 +3100,37 @@ STATUS game_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key) {
       // UFO logic
       if (game->ufo == NULL) {
 #if UFO_TIMER
-        if (++game->ufo_timer >= UFO_SPAWN_DELAY) {
-          game->ufo_timer = 0;
+        if (++game->sim.ufo_timer >= UFO_SPAWN_DELAY) {
+          game->sim.ufo_timer = 0;
 #else
-        if (rand() % UFO_SPAWN_CHANCE == 0) {
+        if (game_rand(game) % UFO_SPAWN_CHANCE == 0) {
 #endif
-          int side = (rand() % 2 == 0 ? -1 : 1);
-          game->ufo_dir = side;
-          float sx = (side == -1 ? (float)CANVAS_WIDTH : (float)FRAME_WIDTH);
-          game->ufo = obj_create(game->ufo_img, 0, 0, UFO_WIDTH, UFO_HEIGHT, sx, UFO_INIT_POS_Y, false);
+          int side = (game_rand(game) % 2 == 0 ? -1 : 1);
+          game->sim.ufo_dir = side;
+          FIXED sx = INT_TO_FIXED(side == -1 ? CANVAS_WIDTH : FRAME_WIDTH);
+          game->ufo = obj_create(SPRITE_UFO, sx, INT_TO_FIXED(UFO_INIT_POS_Y), false);
           if (game->ufo) {
-            al_play_sample(game->samples[3], 1.0, 0.0, 1.0, ALLEGRO_PLAYMODE_LOOP, NULL);
+            game_play_sample(game, 3, 1.0, ALLEGRO_PLAYMODE_LOOP);
           }
         }
       } else {
-        float ux = obj_get_x(game->ufo);
-        if (ux + UFO_WIDTH < (float)FRAME_WIDTH || ux > (float)CANVAS_WIDTH) {
-          al_stop_samples();
+        FIXED ux = obj_get_x(game->ufo);
+        if (ux + INT_TO_FIXED(UFO_WIDTH) < INT_TO_FIXED(FRAME_WIDTH) ||
+            ux > INT_TO_FIXED(CANVAS_WIDTH)) {
+          game_stop_samples(game);
           obj_destroy(game->ufo);
           game->ufo = NULL;
         } else {
-          obj_set_x(game->ufo, ux + (game->ufo_dir * UFO_SPEED));
+          obj_set_x(game->ufo, ux + INT_TO_FIXED(game->sim.ufo_dir * UFO_SPEED));
         }
       }
 
-      if (game->num_enemies_alive <= 0) {
+      if (game->sim.num_enemies_alive <= 0) {
         game_save_highscore(game);
-        game->state = STATE_WIN;
+        game->sim.state = STATE_WIN;
       }
 
-      if (game_move_orphan_bullets(game, MART_BULLET_SPEED) == ERROR) {
+      if (game_move_bullets(game) == ERROR) {
         return ERROR;
       }
 
@@ -2012,42 +3142,323 @@ STATUS game_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key) {
         return ERROR;
       }
 
-      if (game->num_enemies_alive > 0) {
+      if (game->sim.num_enemies_alive > 0) {
         // Select shooter from front row only (closest to player per column)
-        int front_row[MAX_ENEMIES];
-        int front_count = 0;
-        for (int i = 0; i < game->num_enemies_alive; i++) {
-          MARTIAN *m = game->enemy[i];
-          int mx = mart_get_x(m);
-          int my = mart_get_y(m);
-          bool is_front = true;
-          for (int j = 0; j < game->num_enemies_alive; j++) {
-            if (i == j) continue;
-            MARTIAN *other = game->enemy[j];
-            if (abs(mart_get_x(other) - mx) < 5 && mart_get_y(other) > my) {
-              is_front = false;
-              break;
-            }
-          }
-          if (is_front) {
-            front_row[front_count++] = i;
-          }
-        }
-        if (front_count > 0) {
-          game->last_enemy_rand = front_row[rand() % front_count];
-        } else {
-          game->last_enemy_rand = rand() % game->num_enemies_alive;
+        int shooter = form_get_random_shooter(game->formation, game_rand(game));
+        if (shooter >= 0) {
+          game->sim.last_enemy_rand = shooter;
         }
       }
 
-      game->draw = true;
+      game->sim.draw = true;
       break;
 
     default:
       break;
     }
 
-  return OK;
+  // The frame shows the state at the end of the tick
+  if (game->sim.draw) {
+    return game_prepare_frame(game);
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Lowers a tick count to the quiet ticks left before an event.
+ *
+ * @param n Current count.
+ * @param wait Quiet ticks before the event (may be negative).
+ * @return min(n, max(wait, 0)).
+ */
+static int game_ticks_before(int n, int wait) {
+  if (wait < 0) wait = 0;
+  return wait < n ? wait : n;
+}
+
+/**
+ * @brief Counts the upcoming ticks in which nothing observable happens.
+ *
+ * A tick is quiet when the input changes nothing and the only effects of the
+ * tick are counters advancing, martian bullets and the UFO moving in a
+ * straight line, and a random value being drawn. It stops being quiet once
+ * a timer fires (martian step or shot, UFO spawn, animation frame), a
+ * bullet leaves the screen or is due in the impact schedule, the UFO leaves
+ * the screen, or an explosion runs out. Player bullets may hit moving
+ * targets at any time, so no tick is quiet while one is in flight.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param input Player input held during the ticks.
+ * @param max_ticks Most ticks to count.
+ * @return Number of quiet ticks, from 0 to max_ticks.
+ */
+static int game_count_quiet_ticks(GAME *game, const GAME_INPUT *input, int max_ticks) {
+  int n = max_ticks;
+
+  if (game->media.events.type != ALLEGRO_EVENT_TIMER || game->sim.state != STATE_PLAYING ||
+      game->sim.paused || game->sim.ship_exploding || game->sim.num_enemies_alive <= 0 ||
+      game->sim.num_ship_bullets > 0) {
+    return 0;
+  }
+
+  if (input->pause != game->sim.p_was_down || input->escape || input->left || input->right ||
+      input->fire) {
+    return 0;
+  }
+
+  // Martian shot (after the level start pause), step and animation frame
+  n = game_ticks_before(n, game->sim.level_start_delay +
+                               game_ticks_before(INT_MAX, game_shoot_interval(game) -
+                                                              game->sim.enemy_shoot_timer - 1));
+  n = game_ticks_before(n, game_move_interval(game_martian_ratio(game)) -
+                               game->sim.enemy_move_timer - 1);
+  n = game_ticks_before(n, MART_ANIMATION_SPEED - game->sim.enemy_animation_timer);
+
+  // UFO spawn, or UFO leaving the screen
+  if (game->ufo == NULL) {
+#if UFO_TIMER
+    n = game_ticks_before(n, UFO_SPAWN_DELAY - game->sim.ufo_timer - 1);
+#endif
+  } else {
+    FIXED ux = obj_get_x(game->ufo);
+    FIXED step = INT_TO_FIXED(UFO_SPEED);
+
+    if (ux + INT_TO_FIXED(UFO_WIDTH) < INT_TO_FIXED(FRAME_WIDTH) || ux > INT_TO_FIXED(CANVAS_WIDTH)) {
+      return 0;
+    }
+    if (game->sim.ufo_dir > 0) {
+      n = game_ticks_before(n, (INT_TO_FIXED(CANVAS_WIDTH) - ux) / step + 1);
+    } else if (game->sim.ufo_dir < 0) {
+      n = game_ticks_before(n, (ux + INT_TO_FIXED(UFO_WIDTH - FRAME_WIDTH)) / step + 1);
+    }
+  }
+
+  // Martian bullets leaving the screen, or due for a collision test
+  for (int i = 0; i < slotmap_count(game->bullets); i++) {
+    FIXED room = INT_TO_FIXED(CANVAS_HEIGHT) - bullet_y(slotmap_at(game->bullets, i)) - 1;
+    n = game_ticks_before(n, room < 0 ? 0 : room / INT_TO_FIXED(MART_BULLET_SPEED));
+  }
+
+  if (!bullet_schedule_is_empty(&game->schedule)) {
+    n = game_ticks_before(n, (int)(bullet_schedule_top(&game->schedule)->tick -
+                                   game->sim.bullet_tick) - 1);
+  }
+
+  // Explosions age once per tick; the tick that removes one is not quiet
+  for (int i = 0; i < slotmap_size(game->objects); i++) {
+    n = game_ticks_before(n, OBJECT_TIMER - obj_get_time(slotmap_get_at(game->objects, i)) - 1);
+  }
+
+  return n;
+}
+
+/**
+ * @brief Skips the upcoming ticks in which nothing observable happens.
+ *
+ * For headless runs. The game ends up exactly as if game_update() had been
+ * called once per skipped tick with the same input, but the counters and
+ * straight-line moves are advanced in one step. The tick that ends the
+ * quiet stretch is left to game_update().
+ *
+ * @param game Pointer to the GAME instance.
+ * @param input Player input held during the skipped ticks.
+ * @param max_ticks Most ticks to skip.
+ * @return Number of ticks skipped (0 if the next tick is not quiet).
+ */
+int game_skip_quiet_ticks(GAME *game, const GAME_INPUT *input, int max_ticks) {
+  uint32_t rng;
+  int value = 0;
+  int n;
+
+  if (!game || !input || max_ticks <= 0) {
+    return 0;
+  }
+
+  n = game_count_quiet_ticks(game, input, max_ticks);
+
+  // Replay the random draws of the quiet ticks on a copy of the generator;
+  // without the spawn timer, a draw may bring the UFO in and end the stretch
+  rng = game->sim.rng;
+  for (int t = 0; t < n; t++) {
+#if !UFO_TIMER
+    if (game->ufo == NULL) {
+      uint32_t before = rng;
+
+      if (game_rand_next(&rng) % UFO_SPAWN_CHANCE == 0) {
+        rng = before;
+        n = t;
+        break;
+      }
+    }
+#endif
+    value = game_rand_next(&rng);
+  }
+
+  if (n == 0) {
+    return 0;
+  }
+
+  game->sim.rng = rng;
+
+  ship_set_dir(game->ship, NO_DIR);
+
+  if (game->sim.level_start_delay >= n) {
+    game->sim.level_start_delay -= n;
+  } else {
+    game->sim.enemy_shoot_timer += n - game->sim.level_start_delay;
+    game->sim.level_start_delay = 0;
+  }
+  game->sim.enemy_move_timer += n;
+  game->sim.enemy_animation_timer += n;
+
+  if (game->ufo == NULL) {
+#if UFO_TIMER
+    game->sim.ufo_timer += n;
+#endif
+  } else {
+    obj_set_x(game->ufo, obj_get_x(game->ufo) + n * INT_TO_FIXED(game->sim.ufo_dir * UFO_SPEED));
+  }
+
+  // Only martian bullets are in flight; the last step is a real move so
+  // the bullets keep the sweep of a single tick
+  game->sim.bullet_tick += n;
+  for (int i = 0; i < slotmap_count(game->bullets); i++) {
+    BULLET *bullet = slotmap_at(game->bullets, i);
+
+    bullet_set_y(bullet, bullet_y(bullet) + (n - 1) * INT_TO_FIXED(MART_BULLET_SPEED));
+    bullet_move(bullet, INT_TO_FIXED(MART_BULLET_SPEED));
+  }
+
+  game->num_hits = 0;
+  game_martians_erase_bunkers(game);
+
+  // The formation did not change, so only the last shooter pick counts
+  int shooter = form_get_random_shooter(game->formation, value);
+  if (shooter >= 0) {
+    game->sim.last_enemy_rand = shooter;
+  }
+
+  // game_prepare_frame() ages the explosions for the last tick
+  for (int i = 0; i < slotmap_size(game->objects); i++) {
+    OBJECT *object = slotmap_get_at(game->objects, i);
+
+    for (int t = 1; t < n; t++) {
+      obj_set_timer(object, OBJECT_TIMER);
+    }
+  }
+
+  game->sim.draw = true;
+  game_prepare_frame(game);
+
+  return n;
+}
+
+/**
+ * @brief Mixes one value into a running FNV-1a hash.
+ *
+ * @param hash Running hash.
+ * @param value Value to mix in.
+ * @return Updated hash.
+ */
+static uint64_t game_hash_mix(uint64_t hash, int64_t value) {
+  for (int b = 0; b < 8; b++) {
+    hash ^= (uint8_t)(value >> (8 * b));
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+/**
+ * @brief Hashes the simulation state of the game.
+ *
+ * Covers every value a tick reads or writes (the scalars of the tick, the
+ * ship, formation, bullets, impact schedule, bunkers, UFO and explosions),
+ * so two games that hash alike play on identically. Headless checks
+ * compare it between a game that skips quiet ticks and one that steps
+ * through them.
+ *
+ * @param game Pointer to the GAME instance.
+ * @return Hash of the state, or 0 if game is NULL.
+ */
+uint64_t game_state_hash(GAME *game) {
+  uint64_t hash = 14695981039346656037ULL;
+  GAME_SIM *sim;
+
+  if (!game) {
+    return 0;
+  }
+
+  sim = &game->sim;
+  int64_t scalars[] = {
+      sim->state, sim->done, sim->paused, sim->p_was_down, sim->ship_exploding,
+      sim->extra_life_1500_awarded, sim->num_enemies_destroyed, sim->num_enemies_alive,
+      sim->last_enemy_rand, sim->enemy_shoot_timer, sim->enemy_animation_timer,
+      sim->enemy_move_timer, sim->level_start_delay, sim->num_ship_bullets, sim->bullet_tick,
+      sim->ship_explosion_timer, sim->ufo_timer, sim->ufo_dir, sim->total_score, sim->rng,
+      sim->level, sim->level_y_offset, sim->title_timer};
+  for (size_t i = 0; i < sizeof(scalars) / sizeof(scalars[0]); i++) {
+    hash = game_hash_mix(hash, scalars[i]);
+  }
+
+  hash = game_hash_mix(hash, ship_get_x(game->ship));
+  hash = game_hash_mix(hash, ship_get_dir(game->ship));
+  hash = game_hash_mix(hash, ship_get_life(game->ship));
+
+  hash = game_hash_mix(hash, form_get_x(game->formation));
+  hash = game_hash_mix(hash, form_get_y(game->formation));
+  hash = game_hash_mix(hash, form_get_dir(game->formation));
+  hash = game_hash_mix(hash, form_get_source_x(game->formation));
+  for (int i = 0; i < form_get_size(game->formation); i++) {
+    hash = game_hash_mix(hash, form_is_alive(game->formation, i));
+  }
+
+  for (int i = 0; i < slotmap_count(game->bullets); i++) {
+    BULLET *bullet = slotmap_at(game->bullets, i);
+
+    hash = game_hash_mix(hash, bullet_x(bullet));
+    hash = game_hash_mix(hash, bullet_y(bullet));
+    hash = game_hash_mix(hash, bullet_prev_y(bullet));
+    hash = game_hash_mix(hash, bullet_owner(bullet));
+    hash = game_hash_mix(hash, bullet_get_source_x(bullet));
+  }
+
+  // Live entries are summed so the heap layout, which depends on when
+  // stale entries were pruned, does not matter; due bullets are handled in
+  // slot order anyway
+  uint64_t due = 0;
+  for (int k = 0; k < bullet_schedule_size(&game->schedule); k++) {
+    const BULLET_DUE *entry = &game->schedule.items[k];
+
+    if (slotmap_get(game->bullets, entry->bullet)) {
+      due += game_hash_mix(game_hash_mix(hash, entry->tick), entry->bullet);
+    }
+  }
+  hash = game_hash_mix(hash, (int64_t)due);
+
+  for (int i = 0; i < NUM_BUNKERS; i++) {
+    if (game->bunkers[i]) {
+      for (int r = 0; r < BUNKER_HEIGHT; r++) {
+        hash = game_hash_mix(hash, (int64_t)game->bunkers[i]->rows[r]);
+      }
+    }
+  }
+
+  if (game->ufo) {
+    hash = game_hash_mix(hash, obj_get_x(game->ufo));
+    hash = game_hash_mix(hash, obj_get_y(game->ufo));
+  }
+
+  for (int i = 0; i < slotmap_size(game->objects); i++) {
+    OBJECT *object = slotmap_get_at(game->objects, i);
+
+    hash = game_hash_mix(hash, obj_get_x(object));
+    hash = game_hash_mix(hash, obj_get_y(object));
+    hash = game_hash_mix(hash, obj_get_time(object));
+  }
+
+  return hash;
 }
 
 // =========================================================================
@@ -2055,83 +3466,60 @@ STATUS game_update(GAME *game, ALLEGRO_KEYBOARD_STATE *key) {
 // =========================================================================
 
 /**
- * @brief Renders the player's ship and its bullets.
+ * @brief Records the sprites of the frame in the draw list.
+ *
+ * Rendering only replays the list, so it never reads the entities.
  *
  * @param game Pointer to the GAME instance.
- * @return OK if rendering is successful, ERROR if game is NULL.
  */
-STATUS game_print_ship(GAME *game) {
-  if (!game) {
-    return ERROR;
-  }
+static void game_build_draw_list(GAME *game) {
+  DRAW_LIST *list = game->draw_list;
 
-  ship_print(game->ship);
+  drawlist_clear(list);
 
-  for (int i = 0; i < ship_get_num_shots(game->ship); i++) {
-    bullet_print(ship_get_bullet_at(game->ship, i));
-  }
-
-  return OK;
-}
-
-/**
- * @brief Renders all alive martians and their bullets.
- *
- * @param game Pointer to the GAME instance.
- * @return OK if rendering is successful, ERROR if game is NULL.
- */
-STATUS game_print_enemies(GAME *game) {
-  if (!game) {
-    return ERROR;
-  }
+  // Always draw enemies (visible on title screen too); bunkers are part
+  // of the cached scene
+  form_queue_draw(game->formation, list, LAYER_MARTIANS);
 
-  for (int i = 0; i < game->num_enemies_alive; i++) {
-    mart_print(game->enemy[i]);
+  if (game->sim.state != STATE_TITLE) {
+    ship_queue_draw(game->ship, list, LAYER_SHIP);
 
-    for (int j = 0; j < mart_get_num_shots(game->enemy[i]); j++) {
-      BULLET *bullet = mart_get_bullet_at(game->enemy[i], j);
-      bullet_print(bullet);
+    if (game->ufo != NULL) {
+      obj_queue_draw(game->ufo, list, LAYER_UFO);
     }
-  }
 
-  return OK;
-}
+    for (int i = 0; i < slotmap_count(game->bullets); i++) {
+      bullet_queue_draw(slotmap_at(game->bullets, i), list, LAYER_BULLETS);
+    }
 
-/**
- * @brief Renders all orphan bullets currently in the game.
- *
- * @param game Pointer to the GAME instance.
- * @return OK if rendering is successful, ERROR if game is NULL.
- */
-STATUS game_print_orphan_bullets(GAME *game) {
-  if (!game) {
-    return ERROR;
-  }
+    for (int i = slotmap_size(game->objects) - 1; i >= 0; i--) {
+      obj_queue_draw(slotmap_get_at(game->objects, i), list, LAYER_EFFECTS);
+    }
 
-  for (int i = 0; i < game->num_orphan_bullets; i++) {
-    BULLET *bullet = game_get_orphan_bullet_at(game, i);
-    bullet_print(bullet);
+    // Ship icons for remaining lives
+    for (int i = 0; i < ship_get_life(game->ship); i++) {
+      drawlist_push(list, LAYER_HUD, SPRITE_SHIP, ship_get_source_x(game->ship),
+                    ship_get_source_y(game->ship),
+                    INT_TO_FIXED(CANVAS_WIDTH - 105 + i * ship_get_width(game->ship)),
+                    INT_TO_FIXED(120));
+    }
   }
 
-  return OK;
+  drawlist_sort(list);
 }
 
 /**
- * @brief Renders other non-bullet, non-ship objects like explosions.
+ * @brief Advances the timer of every explosion shown in the frame.
  *
- * Handles timer-based destruction of temporary objects.
+ * Explosions are destroyed once they have been shown for OBJECT_TIMER frames.
  *
  * @param game Pointer to the GAME instance.
- * @return OK if rendering is successful, ERROR if game is NULL.
+ * @return OK if successful, ERROR if an object cannot be destroyed.
  */
-STATUS game_print_other_elements(GAME *game) {
-  if (!game) {
-    return ERROR;
-  }
+static STATUS game_age_objects(GAME *game) {
+  for (int i = slotmap_size(game->objects) - 1; i >= 0; i--) {
+    OBJECT *object = slotmap_get_at(game->objects, i);
 
-  for (int i = game->num_objects - 1; i >= 0; i--) {
-    OBJECT *object = game->objects[i];
-    obj_print(object);
     obj_set_timer(object, OBJECT_TIMER);
     // Destruir objeto al completar un ciclo (20 frames)
     if (obj_get_time(object) == 0) {
@@ -2145,56 +3533,62 @@ STATUS game_print_other_elements(GAME *game) {
 }
 
 /**
- * @brief Renders the player's current score on the screen.
+ * @brief Prepares the frame of a tick that is going to be shown.
+ *
+ * Records the sprites of the frame, then ages the explosions drawn in it,
+ * so each one is shown for exactly OBJECT_TIMER frames.
  *
  * @param game Pointer to the GAME instance.
- * @return OK if rendering is successful, ERROR if game is NULL.
+ * @return OK if successful, ERROR if an object cannot be destroyed.
  */
-STATUS game_print_score(GAME *game) {
-  char buf[16];
+static STATUS game_prepare_frame(GAME *game) {
+  game_build_draw_list(game);
 
-  if (!game) {
-    return ERROR;
+  // Explosions are not shown, and do not age, on the title screen
+  if (game->sim.state == STATE_TITLE) {
+    return OK;
   }
 
-  // SCORE (left)
-  al_draw_text(game->font, al_map_rgb(255, 255, 255), FRAME_WIDTH + 10, 120, 0, "SCORE");
-  sprintf(buf, "%d", game->total_score);
-  al_draw_text(game->font, al_map_rgb(0, 255, 0), FRAME_WIDTH + 90, 120, 0, buf);
-
-  // HI-SCORE and LEVEL (second line)
-  al_draw_text(game->font, al_map_rgb(255, 255, 255), FRAME_WIDTH + 10, 140, 0, "HI-SCORE");
-  sprintf(buf, "%d", game->high_score);
-  al_draw_text(game->font, al_map_rgb(0, 255, 0), FRAME_WIDTH + 120, 140, 0, buf);
-
-  al_draw_text(game->font, al_map_rgb(255, 255, 255), CANVAS_WIDTH - 180, 140, 0, "LEVEL");
-  sprintf(buf, "%d", game->level);
-  al_draw_text(game->font, al_map_rgb(0, 255, 0), CANVAS_WIDTH - 110, 140, 0, buf);
-
-  return OK;
+  return game_age_objects(game);
 }
 
 /**
- * @brief Renders the player's remaining lives as ship icons.
+ * @brief Renders the player's current score on the screen.
+ *
+ * The labels and numbers come from the text cache, so a number is only
+ * formatted and rendered again on the frame it changes.
  *
  * @param game Pointer to the GAME instance.
+ * @param frame Frame being drawn.
  * @return OK if rendering is successful, ERROR if game is NULL.
  */
-STATUS game_print_life(GAME *game) {
-  if (!game) {
+STATUS game_print_score(GAME *game, const RENDER_SNAPSHOT *frame) {
+  TEXT_CACHE *texts = NULL;
+  ALLEGRO_COLOR white = al_map_rgb(255, 255, 255);
+  ALLEGRO_COLOR green = al_map_rgb(0, 255, 0);
+
+  if (!game || !frame) {
     return ERROR;
   }
 
-  // Draw ship icons for remaining lives
-  al_draw_text(game->font, al_map_rgb(255, 255, 255), CANVAS_WIDTH - 180, 120, 0, "LIVES");
-  for (int i = 0, space_btw = 0; i < ship_get_life(game->ship);
-       i++, space_btw += (ship_get_width(game->ship))) {
-    al_draw_bitmap_region(ship_get_bitmap(game->ship),
-        (ship_get_source_x(game->ship) * ship_get_width(game->ship)),
-        (ship_get_source_y(game->ship) * ship_get_height(game->ship)),
-        ship_get_width(game->ship), ship_get_height(game->ship),
-        (CANVAS_WIDTH - 105) + space_btw, 120, 0);
-  }
+  texts = game->media.texts;
+
+  // LIVES label (the ship icons are in the draw list)
+  textcache_draw(texts, TEXT_LIVES, white, CANVAS_WIDTH - 180, 120, 0, "LIVES");
+
+  // SCORE (left)
+  textcache_draw(texts, TEXT_SCORE_LABEL, white, FRAME_WIDTH + 10, 120, 0, "SCORE");
+  textcache_draw_number(texts, TEXT_SCORE, green, FRAME_WIDTH + 90, 120, 0, "%d",
+                        frame->total_score);
+
+  // HI-SCORE and LEVEL (second line)
+  textcache_draw(texts, TEXT_HIGH_SCORE_LABEL, white, FRAME_WIDTH + 10, 140, 0, "HI-SCORE");
+  textcache_draw_number(texts, TEXT_HIGH_SCORE, green, FRAME_WIDTH + 120, 140, 0, "%d",
+                        frame->high_score);
+
+  textcache_draw(texts, TEXT_LEVEL_LABEL, white, CANVAS_WIDTH - 180, 140, 0, "LEVEL");
+  textcache_draw_number(texts, TEXT_LEVEL, green, CANVAS_WIDTH - 110, 140, 0, "%d",
+                        frame->level);
 
   return OK;
 }
@@ -2221,192 +3615,584 @@ STATUS game_print_floor(GAME *game) {
 }
 
 /**
- * @brief Main render function to draw all game elements.
+ * @brief Redraws the cached scene if its static layers changed.
  *
- * Draws the background, frame, ship, enemies, bullets, score, lives, and floor.
+ * The scene holds everything that does not move: the background, the
+ * bunkers, the floor and the frame. It is composited again only when a
+ * bunker lost pixels (or was rebuilt) or the floor appeared or went away,
+ * so most frames reuse it with a single blit. Bunkers are compared with
+ * the masks the scene was last composited from, since frames published
+ * in between may never have been drawn.
  *
  * @param game Pointer to the GAME instance.
- * @return OK if rendering is successful, ERROR if game is NULL.
+ * @param frame Frame being drawn.
+ * @param dirty If not NULL, gets the areas of the screen whose scene changed.
  */
-STATUS game_render(GAME *game) {
-  if (!game) {
-    return ERROR;
+static void game_compose_scene(GAME *game, RENDER_SNAPSHOT *frame, DIRTY_MAP *dirty) {
+  GAME_MEDIA *media = &game->media;
+  bool floor = frame->state != STATE_TITLE;
+  bool valid = media->scene_valid && media->scene_floor == floor;
+  bool stale[NUM_BUNKERS];
+  bool changed = !valid;
+  ALLEGRO_STATE state;
+
+  for (int i = 0; i < NUM_BUNKERS; i++) {
+    stale[i] = frame->has_bunker[i] != media->scene_bunker[i] ||
+               (frame->has_bunker[i] &&
+                memcmp(frame->bunkers[i].rows, media->scene_rows[i], sizeof(media->scene_rows[i])) != 0);
+    if (stale[i]) {
+      changed = true;
+      // A bunker that went away leaves a hole the size of the whole scene
+      valid = valid && frame->has_bunker[i];
+      if (dirty && frame->has_bunker[i]) {
+        dirtymap_mark(dirty, FIXED_TO_INT(bunker_x(&frame->bunkers[i])),
+                      FIXED_TO_INT(bunker_y(&frame->bunkers[i])), BUNKER_WIDTH, BUNKER_HEIGHT);
+      }
+    }
+  }
+
+  if (!changed) {
+    return;
   }
 
-  if (game->draw == true) {
-    al_draw_bitmap(game->background, 0, 0, -10);
-    // Frame will be drawn last to clip out-of-bounds content
+  if (dirty && !valid) {
+    dirtymap_mark_all(dirty);
+  }
 
-    // Always draw enemies and bunkers (visible on title screen too)
-    if (game_print_enemies(game) == ERROR) {
-      return ERROR;
-    }
+  al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP);
+  al_set_target_bitmap(media->scene);
 
-    for (int i = 0; i < NUM_BUNKERS * BUNKER_PARTS; i++) {
-      if (game->bunkers[i] != NULL) {
-        bunker_print(game->bunkers[i]);
+  al_draw_bitmap(media->background, 0, 0, 0);
+
+  for (int i = 0; i < NUM_BUNKERS; i++) {
+    media->scene_bunker[i] = frame->has_bunker[i];
+    if (frame->has_bunker[i]) {
+      if (stale[i]) {
+        bunker_write_image(&frame->bunkers[i]);
+        memcpy(media->scene_rows[i], frame->bunkers[i].rows, sizeof(media->scene_rows[i]));
       }
+      bunker_print(&frame->bunkers[i]);
     }
+  }
 
-    if (game->state != STATE_TITLE) {
-      if (game_print_ship(game) == ERROR) {
-        return ERROR;
-      }
+  if (floor) {
+    game_print_floor(game);
+  }
 
-      if (game->ufo != NULL) {
-        obj_print(game->ufo);
-      }
+  // Sprites are clipped to the window of the frame instead of being covered by it
+  al_draw_bitmap(media->frame, 0, 0, 0);
 
-      if (game_print_orphan_bullets(game) == ERROR) {
-        return ERROR;
-      }
+  al_restore_state(&state);
 
-      if (game_print_other_elements(game) == ERROR) {
-        return ERROR;
-      }
+  media->scene_valid = true;
+  media->scene_floor = floor;
+}
 
-      if (game_print_score(game) == ERROR) {
-        return ERROR;
-      }
+/**
+ * @brief Whether a screen or message is drawn over the game.
+ */
+static bool game_has_overlay(const RENDER_SNAPSHOT *frame) {
+  return frame->state != STATE_PLAYING || frame->paused;
+}
 
-      if (game_print_life(game) == ERROR) {
-        return ERROR;
-      }
+/**
+ * @brief Draws the whole frame, or the part of it inside an area, to the target bitmap.
+ *
+ * Draws the cached scene (background, bunkers, floor and frame), the
+ * sprites recorded in the draw list at the end of the tick, then the score
+ * and overlays. The sprites all come from the texture atlas and go out in
+ * a single al_draw_prims() call, clipped to the window of the frame. Text
+ * is blitted from the text cache, one slot per line.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param frame Frame to draw.
+ * @param area Area to redraw, or NULL for the whole screen.
+ * @return OK if rendering is successful, ERROR otherwise.
+ */
+static STATUS game_draw_frame(GAME *game, RENDER_SNAPSHOT *frame, const DIRTY_RECT *area) {
+  TEXT_CACHE *texts = game->media.texts;
+  DIRTY_RECT all = {0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT};
 
-      if (game_print_floor(game) == ERROR) {
-        return ERROR;
-      }
+  if (!area) {
+    area = &all;
+  }
+
+  // Static layers: a blit of the cached scene, which covers the screen
+  al_set_clipping_rectangle(area->x, area->y, area->w, area->h);
+  al_draw_bitmap_region(game->media.scene, area->x, area->y, area->w, area->h, area->x, area->y,
+                        0);
+
+  // Every sprite of the frame, one call per texture, kept inside the frame
+  int x0 = area->x > FRAME_WINDOW_X ? area->x : FRAME_WINDOW_X;
+  int y0 = area->y > FRAME_WINDOW_Y ? area->y : FRAME_WINDOW_Y;
+  int x1 = area->x + area->w < FRAME_WINDOW_X + FRAME_WINDOW_WIDTH
+               ? area->x + area->w
+               : FRAME_WINDOW_X + FRAME_WINDOW_WIDTH;
+  int y1 = area->y + area->h < FRAME_WINDOW_Y + FRAME_WINDOW_HEIGHT
+               ? area->y + area->h
+               : FRAME_WINDOW_Y + FRAME_WINDOW_HEIGHT;
+  if (x1 > x0 && y1 > y0) {
+    al_set_clipping_rectangle(x0, y0, x1 - x0, y1 - y0);
+    if (drawlist_submit(frame->draw_list) == ERROR) {
+      al_reset_clipping_rectangle();
+      return ERROR;
     }
+  }
+  al_set_clipping_rectangle(area->x, area->y, area->w, area->h);
 
-    // Draw frame on top to clip everything
-    al_draw_bitmap(game->frame, 0, 0, 0);
+  if (frame->state != STATE_TITLE && area->y < HUD_BOTTOM && area->y + area->h > HUD_TOP) {
+    if (game_print_score(game, frame) == ERROR) {
+      al_reset_clipping_rectangle();
+      return ERROR;
+    }
+  }
 
-    // Title screen overlay — cycles between title and highscore table
-    if (game->state == STATE_TITLE) {
-      al_draw_filled_rectangle(FRAME_WIDTH + 5, 100, CANVAS_WIDTH - 5,
-                               DISPLAY_HEIGHT - 30, al_map_rgba(0, 0, 0, 200));
-      int phase = (game->title_timer / 90) % 2;
+  // Title screen overlay — cycles between title and highscore table
+  if (frame->state == STATE_TITLE) {
+    al_draw_filled_rectangle(FRAME_WIDTH + 5, 100, CANVAS_WIDTH - 5,
+                             DISPLAY_HEIGHT - 30, al_map_rgba(0, 0, 0, 200));
+    int phase = (frame->title_timer / 90) % 2;
 
-      if (phase == 0) {
-        al_draw_text(game->font, al_map_rgb(0, 255, 0),
+    if (phase == 0) {
+      textcache_draw(texts, TEXT_TITLE, al_map_rgb(0, 255, 0),
                      DISPLAY_WIDTH / 2, 190, ALLEGRO_ALIGN_CENTER,
                      "SPACE  INVADERS");
-        al_draw_text(game->font, al_map_rgb(255, 255, 255),
+      textcache_draw(texts, TEXT_PRESS_ENTER, al_map_rgb(255, 255, 255),
                      DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2 + 20,
                      ALLEGRO_ALIGN_CENTER, "PRESS ENTER TO START");
-        int blink = (game->title_timer / 30) % 2;
-        if (blink) {
-          al_draw_text(game->font, al_map_rgb(255, 255, 0),
+      int blink = (frame->title_timer / 30) % 2;
+      if (blink) {
+        textcache_draw(texts, TEXT_ENTER_ARROWS, al_map_rgb(255, 255, 0),
                        DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2 + 50,
                        ALLEGRO_ALIGN_CENTER, "-> ENTER <-");
-        }
-      } else {
-        // Highscore table
-        al_draw_text(game->font, al_map_rgb(255, 255, 0),
+      }
+    } else {
+      // Highscore table
+      textcache_draw(texts, TEXT_TOP_SCORES, al_map_rgb(255, 255, 0),
                      DISPLAY_WIDTH / 2, 140, ALLEGRO_ALIGN_CENTER,
                      "TOP  SCORES");
-        for (int i = 0; i < MAX_TOP_SCORES; i++) {
-          if (game->top_scores[i].score > 0) {
-            char line[32];
-            sprintf(line, "%d.  %-3s  %d", i + 1,
-                    game->top_scores[i].name,
-                    game->top_scores[i].score);
-            al_draw_text(game->font, al_map_rgb(255, 255, 255),
+      for (int i = 0; i < MAX_TOP_SCORES; i++) {
+        if (frame->top_scores[i].score > 0) {
+          char line[32];
+          snprintf(line, sizeof(line), "%d.  %-3s  %d", i + 1,
+                   frame->top_scores[i].name,
+                   frame->top_scores[i].score);
+          textcache_draw(texts, TEXT_TOP_SCORE + i, al_map_rgb(255, 255, 255),
                          DISPLAY_WIDTH / 2, 190 + i * 32,
                          ALLEGRO_ALIGN_CENTER, line);
-          }
         }
-        int blink = (game->title_timer / 30) % 2;
-        if (blink) {
-          al_draw_text(game->font, al_map_rgb(255, 255, 0),
+      }
+      int blink = (frame->title_timer / 30) % 2;
+      if (blink) {
+        textcache_draw(texts, TEXT_ENTER_ARROWS, al_map_rgb(255, 255, 0),
                        DISPLAY_WIDTH / 2, DISPLAY_HEIGHT - 120,
                        ALLEGRO_ALIGN_CENTER, "-> ENTER <-");
-        }
       }
     }
+  }
 
-    // Pause overlay
-    if (game->paused) {
-      al_draw_filled_rectangle(DISPLAY_WIDTH / 2 - 120, DISPLAY_HEIGHT / 2 - 30,
-                               DISPLAY_WIDTH / 2 + 120, DISPLAY_HEIGHT / 2 + 50,
-                               al_map_rgba(0, 0, 0, 200));
-      al_draw_text(game->font, al_map_rgb(255, 255, 0),
+  // Pause overlay
+  if (frame->paused) {
+    al_draw_filled_rectangle(DISPLAY_WIDTH / 2 - 120, DISPLAY_HEIGHT / 2 - 30,
+                             DISPLAY_WIDTH / 2 + 120, DISPLAY_HEIGHT / 2 + 50,
+                             al_map_rgba(0, 0, 0, 200));
+    textcache_draw(texts, TEXT_PAUSED, al_map_rgb(255, 255, 0),
                    DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2,
                    ALLEGRO_ALIGN_CENTER, "PAUSED");
-      al_draw_text(game->font, al_map_rgb(255, 255, 255),
+    textcache_draw(texts, TEXT_PAUSED_HINT, al_map_rgb(255, 255, 255),
                    DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2 + 30,
                    ALLEGRO_ALIGN_CENTER, "PRESS P TO CONTINUE");
-    }
+  }
 
-    // Game over / level clear screens
-    if (game->state == STATE_GAME_OVER) {
-      al_draw_filled_rectangle(DISPLAY_WIDTH / 2 - 150, DISPLAY_HEIGHT / 2 - 60,
-                               DISPLAY_WIDTH / 2 + 150, DISPLAY_HEIGHT / 2 + 60,
-                               al_map_rgba(0, 0, 0, 200));
-      char score_end[32];
-      sprintf(score_end, "SCORE: %d", game->total_score);
-      al_draw_text(game->font, al_map_rgb(255, 0, 0), DISPLAY_WIDTH / 2,
+  // Game over / level clear screens
+  if (frame->state == STATE_GAME_OVER) {
+    al_draw_filled_rectangle(DISPLAY_WIDTH / 2 - 150, DISPLAY_HEIGHT / 2 - 60,
+                             DISPLAY_WIDTH / 2 + 150, DISPLAY_HEIGHT / 2 + 60,
+                             al_map_rgba(0, 0, 0, 200));
+    textcache_draw(texts, TEXT_GAME_OVER, al_map_rgb(255, 0, 0), DISPLAY_WIDTH / 2,
                    DISPLAY_HEIGHT / 2 - 30, ALLEGRO_ALIGN_CENTER, "GAME OVER");
-      al_draw_text(game->font, al_map_rgb(255, 255, 255), DISPLAY_WIDTH / 2,
-                   DISPLAY_HEIGHT / 2, ALLEGRO_ALIGN_CENTER, score_end);
-      al_draw_text(game->font, al_map_rgb(255, 255, 255), DISPLAY_WIDTH / 2,
+    textcache_draw_number(texts, TEXT_GAME_OVER_SCORE, al_map_rgb(255, 255, 255),
+                          DISPLAY_WIDTH / 2, DISPLAY_HEIGHT / 2, ALLEGRO_ALIGN_CENTER,
+                          "SCORE: %d", frame->total_score);
+    textcache_draw(texts, TEXT_GAME_OVER_HINT, al_map_rgb(255, 255, 255), DISPLAY_WIDTH / 2,
                    DISPLAY_HEIGHT / 2 + 30, ALLEGRO_ALIGN_CENTER,
                    "ENTER: PLAY AGAIN   ESC: EXIT");
-    } else if (game->state == STATE_WIN) {
-      al_draw_filled_rectangle(DISPLAY_WIDTH / 2 - 150, DISPLAY_HEIGHT / 2 - 60,
-                               DISPLAY_WIDTH / 2 + 150, DISPLAY_HEIGHT / 2 + 60,
-                               al_map_rgba(0, 0, 0, 200));
-      char level_end[32];
-      sprintf(level_end, "WAVE %d CLEARED!", game->level);
-      al_draw_text(game->font, al_map_rgb(0, 255, 0), DISPLAY_WIDTH / 2,
-                   DISPLAY_HEIGHT / 2 - 30, ALLEGRO_ALIGN_CENTER, level_end);
-      al_draw_text(game->font, al_map_rgb(255, 255, 255), DISPLAY_WIDTH / 2,
+  } else if (frame->state == STATE_WIN) {
+    al_draw_filled_rectangle(DISPLAY_WIDTH / 2 - 150, DISPLAY_HEIGHT / 2 - 60,
+                             DISPLAY_WIDTH / 2 + 150, DISPLAY_HEIGHT / 2 + 60,
+                             al_map_rgba(0, 0, 0, 200));
+    textcache_draw_number(texts, TEXT_WAVE_CLEARED, al_map_rgb(0, 255, 0), DISPLAY_WIDTH / 2,
+                          DISPLAY_HEIGHT / 2 - 30, ALLEGRO_ALIGN_CENTER,
+                          "WAVE %d CLEARED!", frame->level);
+    textcache_draw(texts, TEXT_WAVE_CLEARED_HINT, al_map_rgb(255, 255, 255), DISPLAY_WIDTH / 2,
                    DISPLAY_HEIGHT / 2, ALLEGRO_ALIGN_CENTER,
                    "ENTER: NEXT WAVE   ESC: EXIT");
-    }
+  }
 
-    // Highscore entry overlay
-    if (game->state == STATE_HIGHSCORE_ENTRY) {
-      al_draw_filled_rectangle(FRAME_WIDTH + 10, DISPLAY_HEIGHT / 2 - 105,
-                               CANVAS_WIDTH - 10, DISPLAY_HEIGHT / 2 + 105,
-                               al_map_rgba(0, 0, 0, 210));
-      char entry_score[32];
-      char letters[8];
-      sprintf(entry_score, "SCORE: %d", game->total_score);
-      sprintf(letters, "%c %c %c",
-              game->highscore_letters[0],
-              game->highscore_letters[1],
-              game->highscore_letters[2]);
-
-      al_draw_text(game->font, al_map_rgb(0, 255, 0), DISPLAY_WIDTH / 2,
+  // Highscore entry overlay
+  if (frame->state == STATE_HIGHSCORE_ENTRY) {
+    al_draw_filled_rectangle(FRAME_WIDTH + 10, DISPLAY_HEIGHT / 2 - 105,
+                             CANVAS_WIDTH - 10, DISPLAY_HEIGHT / 2 + 105,
+                             al_map_rgba(0, 0, 0, 210));
+    char letters[8];
+    snprintf(letters, sizeof(letters), "%c %c %c",
+             frame->highscore_letters[0],
+             frame->highscore_letters[1],
+             frame->highscore_letters[2]);
+
+    textcache_draw(texts, TEXT_NEW_HIGH_SCORE, al_map_rgb(0, 255, 0), DISPLAY_WIDTH / 2,
                    DISPLAY_HEIGHT / 2 - 75, ALLEGRO_ALIGN_CENTER,
                    "NEW HIGH SCORE!");
-      al_draw_text(game->font, al_map_rgb(255, 255, 255), DISPLAY_WIDTH / 2,
-                   DISPLAY_HEIGHT / 2 - 45, ALLEGRO_ALIGN_CENTER, entry_score);
-      al_draw_text(game->font, al_map_rgb(255, 255, 0), DISPLAY_WIDTH / 2,
+    textcache_draw_number(texts, TEXT_ENTRY_SCORE, al_map_rgb(255, 255, 255), DISPLAY_WIDTH / 2,
+                          DISPLAY_HEIGHT / 2 - 45, ALLEGRO_ALIGN_CENTER,
+                          "SCORE: %d", frame->total_score);
+    textcache_draw(texts, TEXT_ENTRY_PROMPT, al_map_rgb(255, 255, 0), DISPLAY_WIDTH / 2,
                    DISPLAY_HEIGHT / 2 - 15, ALLEGRO_ALIGN_CENTER, "ENTER YOUR INITIALS:");
-      al_draw_text(game->font, al_map_rgb(255, 255, 255), DISPLAY_WIDTH / 2,
+    textcache_draw(texts, TEXT_ENTRY_INITIALS, al_map_rgb(255, 255, 255), DISPLAY_WIDTH / 2,
                    DISPLAY_HEIGHT / 2 + 15, ALLEGRO_ALIGN_CENTER, letters);
 
-      // Blinking cursor on current position
-      if ((game->highscore_entry_cursor_timer / 4) % 2 == 0) {
-        int cx = DISPLAY_WIDTH / 2 - 20 + game->highscore_entry_pos * 20;
-        al_draw_text(game->font, al_map_rgb(255, 255, 255), cx,
+    // Blinking cursor on current position
+    if ((frame->highscore_entry_cursor_timer / 4) % 2 == 0) {
+      int cx = DISPLAY_WIDTH / 2 - 20 + frame->highscore_entry_pos * 20;
+      textcache_draw(texts, TEXT_ENTRY_CURSOR, al_map_rgb(255, 255, 255), cx,
                      DISPLAY_HEIGHT / 2 + 32, ALLEGRO_ALIGN_CENTER, "_");
-      }
+    }
 
-      al_draw_text(game->font, al_map_rgb(180, 180, 180), DISPLAY_WIDTH / 2,
+    textcache_draw(texts, TEXT_ENTRY_EDIT_HINT, al_map_rgb(180, 180, 180), DISPLAY_WIDTH / 2,
                    DISPLAY_HEIGHT / 2 + 55, ALLEGRO_ALIGN_CENTER,
                    "USE ARROWS TO EDIT");
-      al_draw_text(game->font, al_map_rgb(180, 180, 180), DISPLAY_WIDTH / 2,
+    textcache_draw(texts, TEXT_ENTRY_SAVE_HINT, al_map_rgb(180, 180, 180), DISPLAY_WIDTH / 2,
                    DISPLAY_HEIGHT / 2 + 75, ALLEGRO_ALIGN_CENTER,
                    "ENTER: SAVE   ESC: SKIP");
+  }
+
+  al_reset_clipping_rectangle();
+
+  return OK;
+}
+
+/**
+ * @brief Redraws and presents only the parts of the screen that changed.
+ *
+ * The frame is patched on canvas, a persistent copy of the screen: every
+ * tile covered by a sprite in this frame or the previous one, by a bunker
+ * that lost pixels or by a HUD number that changed is redrawn from the
+ * scene and the draw list. The canvas is then copied to the backbuffer
+ * and flipped once. The whole screen is redrawn instead when an overlay is
+ * shown or went away, or when too much changed for patching to pay off.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param frame Frame to draw.
+ * @return OK if rendering is successful, ERROR otherwise.
+ */
+static STATUS game_render_dirty(GAME *game, RENDER_SNAPSHOT *frame) {
+  GAME_MEDIA *media = &game->media;
+  const DIRTY_RECT *rects = NULL;
+  bool overlay = game_has_overlay(frame);
+  ALLEGRO_STATE state;
+  int num_rects = 0, area = 0;
+  STATUS st = OK;
+
+  if (!media->canvas) {
+    media->canvas = al_create_bitmap(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    media->dirty = dirtymap_create(DISPLAY_WIDTH, DISPLAY_HEIGHT, DIRTY_TILE_SIZE);
+    media->sprites = dirtymap_create(DISPLAY_WIDTH, DISPLAY_HEIGHT, DIRTY_TILE_SIZE);
+    media->prev_sprites = dirtymap_create(DISPLAY_WIDTH, DISPLAY_HEIGHT, DIRTY_TILE_SIZE);
+    if (!media->canvas || !media->dirty || !media->sprites || !media->prev_sprites) {
+      return ERROR;
+    }
+    media->canvas_valid = false;
+  }
+
+  dirtymap_clear(media->dirty);
+  game_compose_scene(game, frame, media->dirty);
+
+  // Sprites: where they are now and where they were (filtered edges may
+  // bleed into the next pixel)
+  dirtymap_clear(media->sprites);
+  for (int i = 0; i < drawlist_size(frame->draw_list); i++) {
+    const DRAW_CMD *cmd = drawlist_at(frame->draw_list, i);
+
+    dirtymap_mark(media->sprites, FIXED_TO_INT(cmd->x), FIXED_TO_INT(cmd->y),
+                  sprite_width(cmd->sprite) + 1, sprite_height(cmd->sprite) + 1);
+  }
+  dirtymap_merge(media->dirty, media->sprites);
+  dirtymap_merge(media->dirty, media->prev_sprites);
+
+  DIRTY_MAP *swap = media->prev_sprites;
+  media->prev_sprites = media->sprites;
+  media->sprites = swap;
+
+  if (media->hud_score != frame->total_score) {
+    dirtymap_mark(media->dirty, FRAME_WIDTH + 90, 120, HUD_VALUE_WIDTH, HUD_VALUE_HEIGHT);
+    media->hud_score = frame->total_score;
+  }
+  if (media->hud_high_score != frame->high_score) {
+    dirtymap_mark(media->dirty, FRAME_WIDTH + 120, 140, HUD_VALUE_WIDTH, HUD_VALUE_HEIGHT);
+    media->hud_high_score = frame->high_score;
+  }
+  if (media->hud_level != frame->level) {
+    dirtymap_mark(media->dirty, CANVAS_WIDTH - 110, 140, HUD_VALUE_WIDTH, HUD_VALUE_HEIGHT);
+    media->hud_level = frame->level;
+  }
+
+  if (media->canvas_valid && !overlay) {
+    num_rects = dirtymap_rects(media->dirty, &rects);
+    for (int i = 0; i < num_rects; i++) {
+      area += rects[i].w * rects[i].h;
+    }
+  }
+
+  al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP);
+  al_set_target_bitmap(media->canvas);
+
+  if (!media->canvas_valid || overlay || num_rects > DIRTY_MAX_RECTS ||
+      area * 2 > DISPLAY_WIDTH * DISPLAY_HEIGHT) {
+    // Full redraw
+    st = game_draw_frame(game, frame, NULL);
+    al_restore_state(&state);
+    if (st == OK) {
+      al_draw_bitmap(media->canvas, 0, 0, 0);
+      al_flip_display();
     }
 
+    // An overlay is not part of the next frame
+    media->canvas_valid = !overlay;
+    return st;
+  }
+
+  for (int i = 0; i < num_rects && st == OK; i++) {
+    st = game_draw_frame(game, frame, &rects[i]);
+  }
+  al_restore_state(&state);
+  if (st == ERROR) {
+    media->canvas_valid = false;
+    return ERROR;
+  }
+
+  // The backbuffer may hold any earlier frame after a flip, so it gets the
+  // whole canvas and the frame is presented once
+  al_draw_bitmap(media->canvas, 0, 0, 0);
+  al_flip_display();
+
+  return OK;
+}
+
+/**
+ * @brief Draws a published frame and presents it.
+ *
+ * Redraws the whole screen and flips it, or with the dirty-rectangle
+ * renderer (see game_set_dirty_rects()) only the parts that changed.
+ * Reads nothing but the frame and the render resources, so it can run on
+ * the render thread while the simulation goes on.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param frame Frame to draw, owned by the caller until it returns.
+ * @return OK if rendering is successful, ERROR otherwise.
+ */
+static STATUS game_draw_snapshot(GAME *game, RENDER_SNAPSHOT *frame) {
+  STATUS st = OK;
+
+  if (game->media.dirty_rects) {
+    return game_render_dirty(game, frame);
+  }
+
+  game_compose_scene(game, frame, NULL);
+  st = game_draw_frame(game, frame, NULL);
+
+  // No clear: the next frame starts with the opaque scene blit
+  if (st == OK) {
     al_flip_display();
-    al_clear_to_color(al_map_rgb(0, 0, 0));
+  }
+
+  return st;
+}
+
+/**
+ * @brief Copies what the renderer needs into the back frame and publishes it.
+ *
+ * The sprites were already recorded into the back frame's draw list by
+ * game_prepare_frame(). After publishing, the game records into the draw
+ * list of the new back frame.
+ *
+ * @param game Pointer to the GAME instance.
+ */
+static void game_publish_frame(GAME *game) {
+  RENDER_SNAPSHOT *frame = &game->frames[triplebuf_back(&game->frame_slots)];
+
+  frame->state = game->sim.state;
+  frame->paused = game->sim.paused;
+  frame->title_timer = game->sim.title_timer;
+  frame->total_score = game->sim.total_score;
+  frame->level = game->sim.level;
+  frame->high_score = game->ui.high_score;
+  frame->highscore_entry_pos = game->ui.highscore_entry_pos;
+  frame->highscore_entry_cursor_timer = game->ui.highscore_entry_cursor_timer;
+  memcpy(frame->highscore_letters, game->ui.highscore_letters, sizeof(frame->highscore_letters));
+  memcpy(frame->top_scores, game->ui.top_scores, sizeof(frame->top_scores));
+
+  for (int i = 0; i < NUM_BUNKERS; i++) {
+    frame->has_bunker[i] = game->bunkers[i] != NULL;
+    if (frame->has_bunker[i]) {
+      frame->bunkers[i] = *game->bunkers[i];
+    }
+  }
+
+  frame = &game->frames[triplebuf_publish(&game->frame_slots)];
+  game->draw_list = frame->draw_list;
+}
+
+/**
+ * @brief Main render function to draw all game elements.
+ *
+ * Publishes the frame recorded at the end of the last tick. With a render
+ * thread running (see game_start_render_thread()) the thread is woken up
+ * to draw it and this returns at once; otherwise the frame is drawn and
+ * presented here.
+ *
+ * @param game Pointer to the GAME instance.
+ * @return OK if rendering is successful, ERROR if game is NULL or drawing failed.
+ */
+STATUS game_render(GAME *game) {
+  GAME_MEDIA *media = NULL;
+
+  if (!game) {
+    return ERROR;
+  }
+
+  media = &game->media;
+  if (atomic_load(&media->render_failed)) {
+    return ERROR;
+  }
+
+  if (game->sim.draw == true) {
+    game_publish_frame(game);
+    game->sim.draw = false;
+
+    if (media->render_thread) {
+      al_lock_mutex(media->render_mutex);
+      al_signal_cond(media->render_cond);
+      al_unlock_mutex(media->render_mutex);
+      return OK;
+    }
+
+    triplebuf_acquire(&game->frame_slots);
+    return game_draw_snapshot(game, &game->frames[triplebuf_front(&game->frame_slots)]);
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Body of the render thread.
+ *
+ * Sleeps until a frame is published, then draws the latest one. Frames
+ * published while it was still presenting the previous one are skipped,
+ * so a slow flip never holds back the simulation.
+ *
+ * @param thread The render thread.
+ * @param arg Pointer to the GAME instance.
+ * @return NULL.
+ */
+static void *game_render_thread(ALLEGRO_THREAD *thread, void *arg) {
+  GAME *game = (GAME *)arg;
+  GAME_MEDIA *media = &game->media;
+
+  // The display's drawing context moves to this thread
+  al_set_target_backbuffer(media->screen);
+
+  for (;;) {
+    al_lock_mutex(media->render_mutex);
+    while (!al_get_thread_should_stop(thread) && !triplebuf_fresh(&game->frame_slots)) {
+      al_wait_cond(media->render_cond, media->render_mutex);
+    }
+    al_unlock_mutex(media->render_mutex);
+
+    if (al_get_thread_should_stop(thread)) {
+      break;
+    }
+
+    triplebuf_acquire(&game->frame_slots);
+    if (game_draw_snapshot(game, &game->frames[triplebuf_front(&game->frame_slots)]) == ERROR) {
+      atomic_store(&media->render_failed, true);
+      break;
+    }
+  }
+
+  al_set_target_bitmap(NULL);
+
+  return NULL;
+}
+
+/**
+ * @brief Moves drawing and presenting to a thread of their own.
+ *
+ * From then on game_render() only publishes the frame, and game_update()
+ * keeps its cadence however long al_flip_display() blocks. Call it once
+ * the display is set up; the calling thread must not draw until
+ * game_stop_render_thread().
+ *
+ * @param game Pointer to the GAME instance.
+ * @return OK if the thread runs, ERROR otherwise (rendering stays on the caller's thread).
+ */
+STATUS game_start_render_thread(GAME *game) {
+  GAME_MEDIA *media = NULL;
+
+  if (!game || !game->media.screen || game->media.render_thread) {
+    return ERROR;
+  }
+
+  media = &game->media;
+  media->render_mutex = al_create_mutex();
+  media->render_cond = al_create_cond();
+  media->render_thread = al_create_thread(game_render_thread, game);
+  if (!media->render_mutex || !media->render_cond || !media->render_thread) {
+    game_stop_render_thread(game);
+    return ERROR;
+  }
+
+  // Release the display so the render thread can make it current
+  al_set_target_bitmap(NULL);
+  al_start_thread(media->render_thread);
+
+  return OK;
+}
+
+/**
+ * @brief Stops the render thread and takes drawing back to the calling thread.
+ *
+ * @param game Pointer to the GAME instance.
+ * @return OK on success, ERROR if game is NULL.
+ */
+STATUS game_stop_render_thread(GAME *game) {
+  GAME_MEDIA *media = NULL;
+
+  if (!game) {
+    return ERROR;
+  }
+
+  media = &game->media;
+  if (media->render_thread) {
+    al_set_thread_should_stop(media->render_thread);
+    al_lock_mutex(media->render_mutex);
+    al_broadcast_cond(media->render_cond);
+    al_unlock_mutex(media->render_mutex);
+
+    al_join_thread(media->render_thread, NULL);
+    al_destroy_thread(media->render_thread);
+    media->render_thread = NULL;
+
+    al_set_target_backbuffer(media->screen);
+  }
+
+  if (media->render_cond) {
+    al_destroy_cond(media->render_cond);
+    media->render_cond = NULL;
+  }
 
-    game->draw = false;
+  if (media->render_mutex) {
+    al_destroy_mutex(media->render_mutex);
+    media->render_mutex = NULL;
   }
 
   return OK;
@@ -0,0 +1,237 @@
+/**
+ * @file grid.c
+ * @brief Implementation of the uniform spatial grid.
+ *
+ * Every cell keeps a singly linked list of nodes, and all nodes live in one
+ * dense list that is emptied by grid_clear(). An entity overlapping several
+ * cells gets one node per cell. A query marks each ID it returns with the
+ * current query stamp, so an ID found in several cells is reported once.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#include "grid.h"
+#include "container.h"
+
+#define GRID_NONE -1 ///< End of a cell list
+
+/**
+ * @brief Entry of a cell list.
+ */
+typedef struct {
+  int id;   ///< ID of the inserted entity
+  int next; ///< Next node of the same cell, or GRID_NONE
+} GRID_NODE;
+
+DEFINE_DENSE_LIST(GRID_NODE_LIST, grid_node_list, GRID_NODE)
+
+/**
+ * @struct _grid
+ * @brief Cell lists plus the node storage they point into.
+ */
+struct _grid {
+  int cols, rows;       ///< Number of cells in each direction
+  int cell_size;        ///< Side of a cell in pixels
+  int *cell_head;       ///< First node of each cell, or GRID_NONE
+  GRID_NODE_LIST nodes; ///< Storage for every node
+  int max_id;           ///< IDs must be in [0, max_id)
+  unsigned *stamp;      ///< Last query that returned each ID
+  unsigned query;       ///< Stamp of the current query
+};
+
+/**
+ * @brief Converts a box to the range of cells it overlaps, clamped to the grid.
+ */
+static void grid_cell_range(GRID *grid, FIXED x, FIXED y, int width, int height,
+                            int *c0, int *r0, int *c1, int *r1) {
+  int left = FIXED_TO_INT(x);
+  int top = FIXED_TO_INT(y);
+
+  *c0 = left / grid->cell_size;
+  *r0 = top / grid->cell_size;
+  *c1 = (left + width - 1) / grid->cell_size;
+  *r1 = (top + height - 1) / grid->cell_size;
+
+  if (*c0 < 0) *c0 = 0;
+  if (*r0 < 0) *r0 = 0;
+  if (*c1 >= grid->cols) *c1 = grid->cols - 1;
+  if (*r1 >= grid->rows) *r1 = grid->rows - 1;
+}
+
+/**
+ * @brief Creates an empty grid.
+ *
+ * @param width Width of the covered area in pixels.
+ * @param height Height of the covered area in pixels.
+ * @param cell_size Side of a cell in pixels.
+ * @param max_id IDs stored in the grid must be in [0, max_id).
+ * @param max_nodes Maximum number of (ID, cell) pairs stored at once.
+ * @return Pointer to the created GRID or NULL on failure.
+ */
+GRID *grid_create(int width, int height, int cell_size, int max_id, int max_nodes) {
+  GRID *new_grid = NULL;
+
+  if (width <= 0 || height <= 0 || cell_size <= 0 || max_id <= 0 || max_nodes <= 0) {
+    return NULL;
+  }
+
+  new_grid = (GRID *)malloc(sizeof(GRID));
+  if (!new_grid) {
+    return NULL;
+  }
+
+  new_grid->cols = (width + cell_size - 1) / cell_size;
+  new_grid->rows = (height + cell_size - 1) / cell_size;
+  new_grid->cell_size = cell_size;
+  new_grid->max_id = max_id;
+  new_grid->query = 0;
+
+  new_grid->cell_head = (int *)malloc(new_grid->cols * new_grid->rows * sizeof(int));
+  new_grid->stamp = (unsigned *)calloc(max_id, sizeof(unsigned));
+  grid_node_list_init(&new_grid->nodes, (GRID_NODE *)malloc(max_nodes * sizeof(GRID_NODE)),
+                      max_nodes);
+  if (!new_grid->cell_head || !new_grid->stamp || !new_grid->nodes.items) {
+    grid_destroy(new_grid);
+    return NULL;
+  }
+
+  grid_clear(new_grid);
+
+  return new_grid;
+}
+
+/**
+ * @brief Destroys the grid and frees its memory.
+ *
+ * @param grid Pointer to the GRID to destroy.
+ * @return OK on success, ERROR if grid is NULL.
+ */
+STATUS grid_destroy(GRID *grid) {
+  if (!grid) {
+    return ERROR;
+  }
+
+  free(grid->cell_head);
+  free(grid->stamp);
+  free(grid->nodes.items);
+  free(grid);
+
+  return OK;
+}
+
+/**
+ * @brief Removes every entry from the grid.
+ *
+ * @param grid Pointer to the GRID.
+ * @return OK on success, ERROR if grid is NULL.
+ */
+STATUS grid_clear(GRID *grid) {
+  if (!grid) {
+    return ERROR;
+  }
+
+  for (int i = 0; i < grid->cols * grid->rows; i++) {
+    grid->cell_head[i] = GRID_NONE;
+  }
+
+  grid_node_list_clear(&grid->nodes);
+
+  return OK;
+}
+
+/**
+ * @brief Inserts an ID into every cell overlapped by a box.
+ *
+ * Boxes outside the grid are clamped to its border cells.
+ *
+ * @param grid Pointer to the GRID.
+ * @param id ID of the entity, in [0, max_id).
+ * @param x X-coordinate of the box.
+ * @param y Y-coordinate of the box.
+ * @param width Width of the box in pixels.
+ * @param height Height of the box in pixels.
+ * @return OK on success, ERROR if an argument is invalid or the node storage is full.
+ */
+STATUS grid_insert(GRID *grid, int id, FIXED x, FIXED y, int width, int height) {
+  int c0, r0, c1, r1;
+
+  if (!grid || id < 0 || id >= grid->max_id) {
+    return ERROR;
+  }
+
+  grid_cell_range(grid, x, y, width, height, &c0, &r0, &c1, &r1);
+
+  for (int r = r0; r <= r1; r++) {
+    for (int c = c0; c <= c1; c++) {
+      int cell = r * grid->cols + c;
+      GRID_NODE node = {id, grid->cell_head[cell]};
+
+      if (grid_node_list_push(&grid->nodes, node) == ERROR) {
+        return ERROR;
+      }
+      grid->cell_head[cell] = grid_node_list_size(&grid->nodes) - 1;
+    }
+  }
+
+  return OK;
+}
+
+/**
+ * @brief Collects the IDs stored in the cells overlapped by a box.
+ *
+ * Each ID is reported once, and the IDs are sorted in ascending order so
+ * the caller handles candidates in the same order whatever the cell layout.
+ * The candidates still have to be tested for an actual overlap.
+ *
+ * @param grid Pointer to the GRID.
+ * @param x X-coordinate of the box.
+ * @param y Y-coordinate of the box.
+ * @param width Width of the box in pixels.
+ * @param height Height of the box in pixels.
+ * @param ids Output array of candidate IDs.
+ * @param max_ids Capacity of ids.
+ * @return Number of IDs written to ids, or 0 if grid or ids is NULL.
+ */
+int grid_query(GRID *grid, FIXED x, FIXED y, int width, int height, int *ids, int max_ids) {
+  int c0, r0, c1, r1;
+  int n = 0;
+
+  if (!grid || !ids) {
+    return 0;
+  }
+
+  // Stamps start at 0, so a wrapped counter must clear them first
+  if (++grid->query == 0) {
+    for (int i = 0; i < grid->max_id; i++) {
+      grid->stamp[i] = 0;
+    }
+    grid->query = 1;
+  }
+
+  grid_cell_range(grid, x, y, width, height, &c0, &r0, &c1, &r1);
+
+  for (int r = r0; r <= r1; r++) {
+    for (int c = c0; c <= c1; c++) {
+      for (int i = grid->cell_head[r * grid->cols + c]; i != GRID_NONE;
+           i = grid->nodes.items[i].next) {
+        int id = grid->nodes.items[i].id;
+
+        if (grid->stamp[id] == grid->query || n >= max_ids) {
+          continue;
+        }
+        grid->stamp[id] = grid->query;
+
+        // Insertion sort: queries return a handful of IDs
+        int k = n++;
+        while (k > 0 && ids[k - 1] > id) {
+          ids[k] = ids[k - 1];
+          k--;
+        }
+        ids[k] = id;
+      }
+    }
+  }
+
+  return n;
+}
@@ -82,6 +82,13 @@ void register_event_sources(GAME *game);
  */
 void windows_configuration(GAME *game);
 
+/**
+ * @brief Reads the player input of the tick from the keyboard.
+ *
+ * @param input Pointer to the GAME_INPUT to fill in.
+ */
+void read_input(GAME_INPUT *input);
+
 /**
  * @brief Initializes Allegro and its addons.
  *
@@ -104,7 +111,7 @@ bool init_allegro(Flags *flags);
  */
 int main() {
   GAME *game = NULL;          // Game instance
-  ALLEGRO_KEYBOARD_STATE key; // Stores the state of pressed keys
+  GAME_INPUT input;           // Player input of the current tick
   Flags flags = {false, false, false,
                  false, false, false}; // Initialize all flags to false
 
@@ -128,19 +135,24 @@ int main() {
 
   register_event_sources(game);
 
-  srand(time(NULL));
-  game_set_rand_enemy(game, rand() % MAX_ENEMIES);
+  game_set_seed(game, (unsigned)time(NULL));
   al_start_timer(game_get_timer(game)); // Start the game timer
 
   windows_configuration(game);
 
+  // Drawing and flipping go to their own thread; if it cannot start, the
+  // loop below still renders each frame itself
+  if (game_start_render_thread(game) == ERROR) {
+    fprintf(stderr, "Rendering on the main thread.\n");
+  }
+
   fprintf(stdout, "Starting main game loop.\n");
 
   while (game_is_done(game) != true) {
     al_wait_for_event(game_get_ev_queue(game), game_get_event(game)); // Wait for events
-    al_get_keyboard_state(&key);
+    read_input(&input);
 
-    if (game_update(game, &key) == ERROR) {
+    if (game_update(game, &input) == ERROR) {
       clean_up(&flags, game);
       fprintf(stderr, "Error during update.\n");
       return (EXIT_FAILURE);
@@ -271,6 +283,31 @@ void windows_configuration(GAME *game) {
   return;
 }
 
+/**
+ * @brief Translates the keyboard state into the game's input flags.
+ *
+ * Arrows move (and edit initials), Space fires, Enter confirms, P pauses
+ * and Escape quits.
+ *
+ * @param input Pointer to the GAME_INPUT to fill in.
+ */
+void read_input(GAME_INPUT *input) {
+  ALLEGRO_KEYBOARD_STATE key;
+
+  al_get_keyboard_state(&key);
+
+  input->left = al_key_down(&key, ALLEGRO_KEY_LEFT);
+  input->right = al_key_down(&key, ALLEGRO_KEY_RIGHT);
+  input->up = al_key_down(&key, ALLEGRO_KEY_UP);
+  input->down = al_key_down(&key, ALLEGRO_KEY_DOWN);
+  input->fire = al_key_down(&key, ALLEGRO_KEY_SPACE);
+  input->enter = al_key_down(&key, ALLEGRO_KEY_ENTER);
+  input->pause = al_key_down(&key, ALLEGRO_KEY_P);
+  input->escape = al_key_down(&key, ALLEGRO_KEY_ESCAPE);
+
+  return;
+}
+
 /**
  * @brief Cleans up allocated resources and shuts down initialized Allegro
  * components.
@@ -4,7 +4,8 @@
  *
  * This file provides functions to create, manage, and render generic objects within the game.
  * Objects in this context can represent various game elements, with properties for position,
- * bitmap, dimensions, lifespan, and fixed or dynamic status.
+ * sprite, lifespan, and fixed or dynamic status. The bitmap and dimensions come from the
+ * shared sprite descriptor (see sprite.h).
  * 
  * Author: RGiskard7
  * Date: 13/11/2024
@@ -21,33 +22,27 @@
  * to control animations or other time-based actions.
  */
 struct _object {
-    float x, y;                       ///< X and Y coordinates of the object
-    ALLEGRO_BITMAP *bitmap;           ///< Bitmap representing the object's appearance
-    int source_x, source_y;           ///< Source coordinates within the bitmap
-    int width, height;                ///< Width and height of the object
+    FIXED x, y;                       ///< X and Y coordinates of the object
     int life;                         ///< Lifespan or health of the object
     int timer;                        ///< Timer for time-based events or animations
+    uint8_t sprite;                   ///< Sprite descriptor (SPRITE_ID)
+    uint8_t source_x;                 ///< Animation frame (column in the sprite sheet)
     bool fixed;                       ///< Whether the object is fixed in place
 };
 
 /**
  * @brief Creates a new object with specified properties.
  *
- * @param bitmap Bitmap representing the object's image.
- * @param source_x Source x-coordinate in the bitmap.
- * @param source_y Source y-coordinate in the bitmap.
- * @param width Width of the object.
- * @param height Height of the object.
+ * @param sprite Sprite descriptor of the object.
  * @param cx Initial x-coordinate of the object.
  * @param cy Initial y-coordinate of the object.
  * @param fixed True if the object is fixed in place, false if it is movable.
  * @return Pointer to the created OBJECT structure, or NULL if allocation fails.
  */
-OBJECT *obj_create(ALLEGRO_BITMAP *bitmap, int source_x, int source_y, 
-                   int width, int height, float cx, float cy, bool fixed) {
+OBJECT *obj_create(SPRITE_ID sprite, FIXED cx, FIXED cy, bool fixed) {
     OBJECT *new_object = NULL;
 
-    if (!bitmap) {
+    if (sprite >= NUM_SPRITES) {
         return NULL;
     }
 
@@ -56,16 +51,12 @@ OBJECT *obj_create(ALLEGRO_BITMAP *bitmap, int source_x, int source_y,
         return NULL;
     }
 
-    new_object->bitmap = bitmap;
+    new_object->sprite = sprite;
 
     new_object->x = cx;
     new_object->y = cy;
 
-    new_object->source_x = source_x;
-    new_object->source_y = source_y;
-
-    new_object->width = width;
-    new_object->height = height;
+    new_object->source_x = 0;
 
     new_object->life = 3;
 
@@ -99,7 +90,7 @@ STATUS obj_destroy(OBJECT *object) {
  * @param cx New x-coordinate.
  * @return OK if successful, ERROR if the object is NULL.
  */
-STATUS obj_set_x(OBJECT *object, float cx) {
+STATUS obj_set_x(OBJECT *object, FIXED cx) {
     if (!object) {
         return ERROR;
     }
@@ -115,9 +106,9 @@ STATUS obj_set_x(OBJECT *object, float cx) {
  * @param object Pointer to the OBJECT structure.
  * @return The x-coordinate or ERROR if the object is NULL.
  */
-float obj_get_x(OBJECT *object) {
+FIXED obj_get_x(OBJECT *object) {
     if (!object) {
-        return 0.0f;
+        return 0;
     }
 
     return object->x;
@@ -130,7 +121,7 @@ float obj_get_x(OBJECT *object) {
  * @param cy New y-coordinate.
  * @return OK if successful, ERROR if the object is NULL.
  */
-STATUS obj_set_y(OBJECT *object, float cy) {
+STATUS obj_set_y(OBJECT *object, FIXED cy) {
     if (!object) {
         return ERROR;
     }
@@ -146,37 +137,23 @@ STATUS obj_set_y(OBJECT *object, float cy) {
  * @param object Pointer to the OBJECT structure.
  * @return The y-coordinate or ERROR if the object is NULL.
  */
-float obj_get_y(OBJECT *object) {
+FIXED obj_get_y(OBJECT *object) {
     if (!object) {
-        return 0.0f;
+        return 0;
     }
 
     return object->y;
 }
 
 /**
- * @brief Retrieves the bitmap associated with the object.
+ * @brief Sets the animation frame of the object.
  *
  * @param object Pointer to the OBJECT structure.
- * @return Pointer to the bitmap or NULL if the object is NULL.
- */
-ALLEGRO_BITMAP *obj_get_bitmap(OBJECT *object) {
-    if (!object) {
-        return NULL;
-    }
-
-    return object->bitmap;
-}
-
-/**
- * @brief Sets the x-source coordinate of the object's bitmap.
- *
- * @param object Pointer to the OBJECT structure.
- * @param source_x New x-source coordinate value.
- * @return OK if successful, ERROR if the object is NULL.
+ * @param source_x Frame (column in the sprite sheet).
+ * @return OK if successful, ERROR if the object is NULL or the frame is invalid.
  */
 STATUS obj_set_source_x(OBJECT *object, int source_x) {
-    if (!object) {
+    if (!object || source_x < 0 || source_x > UINT8_MAX) {
         return ERROR;
     }
 
@@ -186,10 +163,10 @@ STATUS obj_set_source_x(OBJECT *object, int source_x) {
 }
 
 /**
- * @brief Retrieves the x-source coordinate of the object's bitmap.
+ * @brief Retrieves the animation frame of the object.
  *
  * @param object Pointer to the OBJECT structure.
- * @return The x-source coordinate or ERROR if the object is NULL.
+ * @return Frame (column in the sprite sheet) or ERROR if the object is NULL.
  */
 int obj_get_source_x(OBJECT *object) {
     if (!object) {
@@ -199,37 +176,6 @@ int obj_get_source_x(OBJECT *object) {
     return object->source_x;
 }
 
-/**
- * @brief Sets the y-source coordinate of the object's bitmap.
- *
- * @param object Pointer to the OBJECT structure.
- * @param source_y New y-source coordinate value.
- * @return OK if successful, ERROR if the object is NULL.
- */
-STATUS obj_set_source_y(OBJECT *object, int source_y) {
-    if (!object) {
-        return ERROR;
-    }
-
-    object->source_y = source_y;
-
-    return OK;
-}
-
-/**
- * @brief Retrieves the y-source coordinate of the object's bitmap.
- *
- * @param object Pointer to the OBJECT structure.
- * @return The y-source coordinate or ERROR if the object is NULL.
- */
-int obj_get_source_y(OBJECT *object) {
-    if (!object) {
-        return ERROR;
-    }
-
-    return object->source_y;
-}
-
 /**
  * @brief Sets the lifespan or health of the object.
  *
@@ -272,7 +218,7 @@ int obj_get_width(OBJECT *object) {
         return 0;
     }
 
-    return object->width;
+    return sprite_get_width(object->sprite);
 }
 
 /**
@@ -286,24 +232,23 @@ int obj_get_height(OBJECT *object) {
         return 0;
     }
 
-    return object->height;
+    return sprite_get_height(object->sprite);
 }
 
 /**
- * @brief Draws the object on the screen.
+ * @brief Appends the object to a draw list.
  *
  * @param object Pointer to the OBJECT structure.
- * @return OK if successful, ERROR if the object is NULL.
+ * @param list Draw list of the frame.
+ * @param layer Layer the object is drawn in.
+ * @return OK if successful, ERROR if the object is NULL or the list is full.
  */
-STATUS obj_print(OBJECT *object) {
+STATUS obj_queue_draw(OBJECT *object, DRAW_LIST *list, DRAW_LAYER layer) {
     if (!object) {
         return ERROR;
     }
 
-    al_draw_bitmap_region(object->bitmap, (object->source_x * object->width), (object->source_y * object->height), 
-        object->width, object->height, object->x, object->y, 0);
-
-    return OK;
+    return drawlist_push(list, layer, object->sprite, object->source_x, 0, object->x, object->y);
 }
 
 /**
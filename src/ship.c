@@ -4,8 +4,8 @@
  * Invaders game.
  *
  * This file contains the functions needed to create and control the ship,
- * including its position, movement, firing capabilities, and handling of
- * the bullets it fires.
+ * including its position, movement and firing capabilities. The bullets it
+ * fires are handed over to the game's bullet array.
  *
  * Author: RGiskard7
  * Date: 13/11/2024
@@ -17,16 +17,14 @@
  * @struct _ship
  * @brief Structure representing the player-controlled ship in the game.
  *
- * The ship structure holds the ship's coordinates, bitmap image, bullets,
+ * The ship structure holds the ship's coordinates, bitmap image,
  * direction, life, and other necessary attributes for managing its behavior
  * in the game.
  */
 struct _ship {
-  float x, y;                        ///< Ship's coordinates
+  FIXED x, y;                        ///< Ship's coordinates
   int dir;                           ///< Ship's direction (e.g., LEFT, RIGHT)
   ALLEGRO_BITMAP *bitmap;            ///< Ship's bitmap image
-  BULLET *bullets[MAX_SHIP_BULLETS]; ///< Array holding ship's bullets
-  long num_shots;                    ///< Number of bullets currently in use
   bool active;                       ///< Ship's active state
   int source_x, source_y;            ///< Source coordinates in bitmap for rendering
   int width, height;                 ///< Dimensions of the ship
@@ -36,7 +34,7 @@ struct _ship {
 /**
  * @brief Creates a new ship with the given parameters.
  *
- * @param bitmap Bitmap image of the ship.
+ * @param bitmap Bitmap image of the ship, or NULL in headless games.
  * @param width Width of the ship.
  * @param height Height of the ship.
  * @param x Initial x-coordinate.
@@ -46,14 +44,10 @@ struct _ship {
  *
  * @return A pointer to the created SHIP structure, or NULL on failure.
  */
-SHIP *ship_create(ALLEGRO_BITMAP *bitmap, int width, int height, float x,
-                  float y, int dir, int life) {
+SHIP *ship_create(ALLEGRO_BITMAP *bitmap, int width, int height, FIXED x,
+                  FIXED y, int dir, int life) {
   SHIP *new_ship = NULL;
 
-  if (!bitmap) {
-    return NULL;
-  }
-
   new_ship = (SHIP *)malloc(sizeof(SHIP));
   if (!new_ship) {
     return NULL;
@@ -74,41 +68,28 @@ SHIP *ship_create(ALLEGRO_BITMAP *bitmap, int width, int height, float x,
 
   new_ship->life = life;
 
-  new_ship->num_shots = 0;
-
   new_ship->active = false;
 
-  // Inicializacion de punteros a bullet
-  for (int i = 0; i < MAX_SHIP_BULLETS; i++) { 
-    new_ship->bullets[i] = NULL;
-  }
-
   return new_ship;
 }
 
 /**
  * @brief Destroys the ship, releasing associated resources.
  *
- * Frees the memory allocated for the ship and its bullets.
+ * Frees the memory allocated for the ship. Its bullets live in the game's
+ * bullet array and are released there.
  *
  * @param ship Pointer to the ship to destroy.
  * @return STATUS code (OK on success, ERROR on failure).
  */
 STATUS ship_destroy(SHIP *ship) { // Destruir ship
-  STATUS result = OK;
-
-  if (ship != NULL) {
-    for (int i = 0; i < MAX_SHIP_BULLETS; i++) {
-      if (ship->bullets[i] != NULL) {
-        if (bullet_destroy(ship->bullets[i]) == ERROR) {
-          result = ERROR;
-        }
-      }
-    }
-    free(ship);
+  if (!ship) {
+    return ERROR;
   }
 
-  return result;
+  free(ship);
+
+  return OK;
 }
 
 /**
@@ -118,7 +99,7 @@ STATUS ship_destroy(SHIP *ship) { // Destruir ship
  * @param x New x-coordinate.
  * @return STATUS code (OK on success, ERROR on failure).
  */
-STATUS ship_set_x(SHIP *ship, float x) {
+STATUS ship_set_x(SHIP *ship, FIXED x) {
   if (ship != NULL) {
     ship->x = x;
     return OK;
@@ -130,13 +111,13 @@ STATUS ship_set_x(SHIP *ship, float x) {
  * @brief Gets the current x-coordinate of the ship.
  *
  * @param ship Pointer to the ship.
- * @return The x-coordinate, or -1.0 if ship is NULL.
+ * @return The x-coordinate, or 0 if ship is NULL.
  */
-float ship_get_x(SHIP *ship) {
+FIXED ship_get_x(SHIP *ship) {
   if (ship != NULL) {
     return ship->x;
   }
-  return 0.0f;
+  return 0;
 }
 
 /**
@@ -146,7 +127,7 @@ float ship_get_x(SHIP *ship) {
  * @param y New y-coordinate.
  * @return STATUS code.
  */
-STATUS ship_set_y(SHIP *ship, float y) {
+STATUS ship_set_y(SHIP *ship, FIXED y) {
   if (ship != NULL) {
     ship->y = y;
     return OK;
@@ -158,13 +139,13 @@ STATUS ship_set_y(SHIP *ship, float y) {
  * @brief Gets the current y-coordinate of the ship.
  *
  * @param ship Pointer to the ship.
- * @return The y-coordinate, or -1.0 on failure.
+ * @return The y-coordinate, or 0 on failure.
  */
-float ship_get_y(SHIP *ship) {
+FIXED ship_get_y(SHIP *ship) {
   if (ship != NULL) {
     return ship->y;
   }
-  return 0.0f;
+  return 0;
 }
 
 /**
@@ -307,34 +288,6 @@ int ship_get_source_y(SHIP *ship) {
   return -1;
 }
 
-/**
- * @brief Sets the current number of shots (bullets) the ship has fired.
- *
- * @param ship Pointer to the ship.
- * @param num_shots New number of shots.
- * @return STATUS code.
- */
-STATUS ship_set_num_shots(SHIP *ship, long num_shots) {
-  if (ship != NULL) {
-    ship->num_shots = num_shots;
-    return OK;
-  }
-  return ERROR;
-}
-
-/**
- * @brief Gets the current number of bullets the ship has fired.
- *
- * @param ship Pointer to the ship.
- * @return The number of shots, or -1 on failure.
- */
-long ship_get_num_shots(SHIP *ship) {
-  if (ship != NULL) {
-    return ship->num_shots;
-  }
-  return -1;
-}
-
 /**
  * @brief Sets the life points for the ship.
  *
@@ -390,20 +343,22 @@ int ship_get_height(SHIP *ship) {
 }
 
 /**
- * @brief Renders the ship on the screen.
+ * @brief Appends the ship to a draw list.
  *
- * @param ship Pointer to the ship to print.
- * @return STATUS code.
+ * The ship is drawn from SPRITE_SHIP, which holds the same sheet as its bitmap.
+ *
+ * @param ship Pointer to the ship.
+ * @param list Draw list of the frame.
+ * @param layer Layer the ship is drawn in.
+ * @return OK on success, ERROR if ship is NULL or the list is full.
  */
-STATUS ship_print(SHIP *ship) {
-  if (ship != NULL && ship->bitmap != NULL) {
-    al_draw_bitmap_region(ship->bitmap, (ship->source_x * ship->width),
-                          (ship->source_y * ship->height), ship->width,
-                          ship->height, ship->x, ship->y, 0);
-
-    return OK;
+STATUS ship_queue_draw(SHIP *ship, DRAW_LIST *list, DRAW_LAYER layer) {
+  if (ship == NULL) {
+    return ERROR;
   }
-  return ERROR;
+
+  return drawlist_push(list, layer, SPRITE_SHIP, ship->source_x, ship->source_y, ship->x,
+                       ship->y);
 }
 
 /**
@@ -422,155 +377,21 @@ STATUS ship_decrease_life(SHIP *ship, int value) {
 }
 
 /**
- * @brief Adds a bullet to the ship's bullet array.
+ * @brief Fires a new bullet from the ship's cannon.
  *
- * @param ship Pointer to the ship.
- * @param bullet Bullet to add.
- * @return STATUS code.
- */
-STATUS ship_add_bullet(SHIP *ship, BULLET *bullet) {
-  if (!ship || !bullet || ship->num_shots >= MAX_SHIP_BULLETS) {
-    return ERROR;
-  }
-
-  ship->bullets[ship->num_shots] = bullet;
-  ship->num_shots++;
-
-  return OK;
-}
-
-/**
- * @brief Removes and returns the oldest bullet in the ship's queue.
+ * The caller takes ownership of the bullet and is responsible for the
+ * limit of bullets in flight (MAX_SHIP_BULLETS).
  *
  * @param ship Pointer to the ship.
- * @return The oldest bullet, or NULL if no bullets are found.
+ * @return Pointer to the new bullet, or NULL on failure.
  */
-BULLET *ship_dequeue_bullet(SHIP *ship) {
-  BULLET *bullet = NULL;
-
-  if (ship != NULL && ship->num_shots > 0) {
-    bullet = ship->bullets[0];
-
-    for (int i = 0; i < ship->num_shots - 1; i++) {
-      ship->bullets[i] = ship->bullets[i + 1];
-    }
-
-    ship->num_shots--;
-    ship->bullets[ship->num_shots] = NULL;
-  }
-
-  return bullet;
-}
-
-/**
- * @brief Removes and returns the bullet at a specified index.
- *
- * @param ship Pointer to the ship.
- * @param i Index of bullet to remove.
- * @return Pointer to the removed bullet or NULL if index is invalid.
- */
- // Bullets behave as a dynamic list: they can be removed
- // in any order, but remaining bullets must be shifted
- // to maintain list continuity
-BULLET *ship_extract_bullet_at(SHIP *ship, int i) {
-  BULLET *bullet = NULL;
-
-  if (ship != NULL && ship->num_shots > 0) {
-    if (i >= 0 && i < ship->num_shots) {
-      if (ship->bullets[i] != NULL) {
-        bullet = ship->bullets[i];
-
-        // Shift all remaining bullets forward
-        for (int j = i; j < ship->num_shots - 1; j++) {
-          ship->bullets[j] = ship->bullets[j + 1];
-        }
-
-        // Decrease bullet count and ensure last slot is NULL
-        ship->num_shots--;
-        ship->bullets[ship->num_shots] = NULL;
-      }
-    }
-  }
-
-  return bullet;
-}
-
-/**
- * @brief Retrieves a bullet at the specified index.
- *
- * @param ship Pointer to the ship.
- * @param i Index of bullet.
- * @return Pointer to the bullet or NULL if index is invalid.
- */
-BULLET *ship_get_bullet_at(SHIP *ship, int i) {
-  if (!ship || i < 0 || i >= ship->num_shots) {
-    return NULL;
-  }
-
-  return ship->bullets[i];
-}
-
-/**
- * @brief Moves all bullets of the ship upwards by a given speed.
- *
- * @param ship Pointer to the ship.
- * @param speed Speed of bullet movement.
- * @return STATUS code.
- */
- // Pasar los limites por parametro
-STATUS ship_move_bullet(SHIP *ship, float speed) {
-  int top_limit = SHIP_BULLET_TOP_LIMIT;
-
+BULLET *ship_shoot(SHIP *ship) {
   if (!ship) {
-    return ERROR;
-  }
-
-  for (int i = ship->num_shots - 1; i >= 0; i--) {
-    // Comprobar si ha llegado a arriba (0)
-    if (bullet_get_y(ship->bullets[i]) - speed > top_limit) {
-      if (bullet_move(ship->bullets[i], speed) == ERROR) {
-        return ERROR;
-      }
-    } else {
-      if (bullet_destroy(ship_extract_bullet_at(ship, i)) == ERROR) {
-        return ERROR;
-      }
-    }
-  }
-
-  return OK;
-}
-
-/**
- * @brief Fires a new bullet from the ship.
- *
- * @param ship Pointer to the ship.
- * @param bitmap Bitmap for the bullet.
- * @return STATUS code.
- */
-STATUS ship_shoot(SHIP *ship, ALLEGRO_BITMAP *bitmap) {
-  BULLET *new_bullet = NULL;
-
-  if (!ship || !bitmap) {
-    return ERROR;
-  }
-
-  if (ship->num_shots >= MAX_SHIP_BULLETS) {
-    return ERROR;
+    return NULL;
   }
 
   // La bullet se situa a 12 por encima
-  new_bullet = bullet_create(bitmap, BULLET_WIDTH, BULLET_HEIGHT, ship->x + 12, ship->y, UP);
-  if (new_bullet == NULL) {
-    return ERROR;
-  }
-
-  if (ship_add_bullet(ship, new_bullet) == ERROR) {
-    bullet_destroy(new_bullet);
-    return ERROR;
-  }
-
-  return OK;
+  return bullet_create(SPRITE_SHIP_BULLET, ship->x + INT_TO_FIXED(12), ship->y, UP, BULLET_SHIP);
 }
 
 /**
@@ -580,7 +401,7 @@ STATUS ship_shoot(SHIP *ship, ALLEGRO_BITMAP *bitmap) {
  * @param speed Speed of movement.
  * @return STATUS code.
  */
-STATUS ship_move(SHIP *ship, float speed) { // Pedir los limites por parametro
+STATUS ship_move(SHIP *ship, FIXED speed) { // Pedir los limites por parametro
   if (!ship) {
     return ERROR;
   }
@@ -596,13 +417,13 @@ STATUS ship_move(SHIP *ship, float speed) { // Pedir los limites por parametro
  * @param y y position.
  * @return bool.
  */
-bool ship_some_loc(SHIP *ship, int x, int y) {
+bool ship_some_loc(SHIP *ship, FIXED x, FIXED y) {
   if (!ship) {
     return false;
   }
 
-  if (x >= ship->x && x <= ship->x + ship->width && y >= ship->y &&
-      y <= ship->y + ship->height) {
+  if (x >= ship->x && x <= ship->x + INT_TO_FIXED(ship->width) && y >= ship->y &&
+      y <= ship->y + INT_TO_FIXED(ship->height)) {
     return true;
   }
 
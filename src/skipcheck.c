@@ -0,0 +1,199 @@
+/**
+ * @file skipcheck.c
+ * @brief Headless check of the quiet-tick skip.
+ *
+ * Plays two games with the same seed and the same scripted input. One calls
+ * game_update() on every tick; the other jumps over quiet stretches with
+ * game_skip_quiet_ticks(). After every step both games must hash alike
+ * (game_state_hash()), otherwise the first tick where they differ is
+ * reported and the check fails.
+ *
+ * The games are set up with game_init_headless(), so no window is opened
+ * and the check runs on machines without a display.
+ *
+ * Usage:
+ * ./SkipCheck [ticks] [seed]
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ * Version: 1.0
+ */
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_image.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "game.h"
+
+#define SKIPCHECK_TICKS 20000 ///< Ticks played when none are given
+#define SKIPCHECK_SEED 7      ///< Seed used when none is given
+#define SKIPCHECK_MAX_SKIP 64 ///< Most ticks skipped in one call
+
+/**
+ * @brief Fills in the input the scripted player gives on a tick.
+ *
+ * Starts a game every 2000 ticks, moves left and right for a while every
+ * 300 ticks and fires now and then, leaving long idle stretches between.
+ *
+ * @param tick Tick number.
+ * @param input Input to fill in.
+ */
+static void skipcheck_input(int tick, GAME_INPUT *input) {
+  memset(input, 0, sizeof(*input));
+
+  input->enter = tick % 2000 < 5;
+  input->left = tick % 300 < 30;
+  input->right = tick % 300 >= 150 && tick % 300 < 180;
+  input->fire = tick % 60 == 0 && tick % 300 < 200;
+}
+
+/**
+ * @brief Counts the ticks from the given one during which the input stays the same.
+ *
+ * @param tick First tick.
+ * @param input Input given on the first tick.
+ * @param max_ticks Most ticks to count.
+ * @return Number of ticks, from 1 to max_ticks.
+ */
+static int skipcheck_held_ticks(int tick, const GAME_INPUT *input, int max_ticks) {
+  GAME_INPUT next;
+  int n = 1;
+
+  while (n < max_ticks) {
+    skipcheck_input(tick + n, &next);
+    if (memcmp(input, &next, sizeof(next)) != 0) {
+      break;
+    }
+    n++;
+  }
+
+  return n;
+}
+
+/**
+ * @brief Runs one tick of the game with the given input.
+ *
+ * @param game Pointer to the GAME instance.
+ * @param input Input given during the tick.
+ * @return OK if successful, ERROR if the update fails.
+ */
+static STATUS skipcheck_step(GAME *game, const GAME_INPUT *input) {
+  game_get_event(game)->type = ALLEGRO_EVENT_TIMER;
+
+  return game_update(game, input);
+}
+
+/**
+ * @brief Creates a headless game that never saves scores.
+ *
+ * @param seed Seed of the game's random sequence.
+ * @return Pointer to the game, or NULL on failure.
+ */
+static GAME *skipcheck_game(unsigned seed) {
+  GAME *game = game_create();
+
+  if (!game) {
+    return NULL;
+  }
+
+  if (game_init_headless(game) == ERROR) {
+    game_destroy(game);
+    return NULL;
+  }
+
+  game_set_persistence(game, false);
+  game_set_seed(game, seed);
+
+  return game;
+}
+
+/**
+ * @brief Plays both games side by side and compares them after every step.
+ *
+ * @param stepped Game updated on every tick.
+ * @param skipping Game that skips quiet ticks.
+ * @param ticks Ticks to play.
+ * @return OK if both games stay identical, ERROR otherwise.
+ */
+static STATUS skipcheck_run(GAME *stepped, GAME *skipping, int ticks) {
+  GAME_INPUT input;
+  long skipped = 0;
+  int tick = 0;
+
+  while (tick < ticks && !game_is_done(stepped)) {
+    int max_ticks = ticks - tick < SKIPCHECK_MAX_SKIP ? ticks - tick : SKIPCHECK_MAX_SKIP;
+    int n;
+
+    skipcheck_input(tick, &input);
+
+    n = game_skip_quiet_ticks(skipping, &input, skipcheck_held_ticks(tick, &input, max_ticks));
+    if (n > 0) {
+      skipped += n;
+    } else if (skipcheck_step(skipping, &input) == ERROR) {
+      fprintf(stderr, "Error during update.\n");
+      return ERROR;
+    }
+
+    for (int i = 0; i < (n > 0 ? n : 1); i++) {
+      if (skipcheck_step(stepped, &input) == ERROR) {
+        fprintf(stderr, "Error during update.\n");
+        return ERROR;
+      }
+    }
+
+    if (game_state_hash(stepped) != game_state_hash(skipping)) {
+      if (n > 0) {
+        fprintf(stderr, "States differ after skipping ticks %d to %d.\n", tick, tick + n - 1);
+      } else {
+        fprintf(stderr, "States differ after tick %d.\n", tick);
+      }
+      return ERROR;
+    }
+
+    tick += n > 0 ? n : 1;
+  }
+
+  fprintf(stdout, "%d ticks checked, %ld skipped: states identical.\n", tick, skipped);
+
+  return OK;
+}
+
+/**
+ * @brief Entry point of the check.
+ *
+ * @param argc Number of arguments.
+ * @param argv Optional tick count and seed.
+ * @return EXIT_SUCCESS if both games stay identical, EXIT_FAILURE otherwise.
+ */
+int main(int argc, char **argv) {
+  int ticks = argc > 1 ? atoi(argv[1]) : SKIPCHECK_TICKS;
+  unsigned seed = argc > 2 ? (unsigned)atoi(argv[2]) : SKIPCHECK_SEED;
+  GAME *stepped, *skipping;
+  STATUS status = ERROR;
+
+  // The image addon reads the bunker sheet, which holds the bunker shape
+  if (!al_init() || !al_init_image_addon()) {
+    fprintf(stderr, "Error initializing Allegro.\n");
+    return EXIT_FAILURE;
+  }
+
+  stepped = skipcheck_game(seed);
+  skipping = skipcheck_game(seed);
+  if (!stepped || !skipping) {
+    fprintf(stderr, "Error initializing game.\n");
+  } else {
+    status = skipcheck_run(stepped, skipping, ticks);
+  }
+
+  if (stepped) {
+    game_destroy(stepped);
+  }
+  if (skipping) {
+    game_destroy(skipping);
+  }
+
+  return status == OK ? EXIT_SUCCESS : EXIT_FAILURE;
+}
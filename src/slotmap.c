@@ -0,0 +1,321 @@
+/**
+ * @file slotmap.c
+ * @brief Implementation of the SlotMap container and its associated functions.
+ *
+ * Items live in a packed array that is reordered by swap-removal. Each
+ * item also owns a slot that records its current position in the packed
+ * array and a generation counter. A handle packs the slot index (low 16
+ * bits) and the generation (high 16 bits). Freeing a slot bumps its
+ * generation, so any handle still referring to the old item is rejected.
+ * Freed slots wait in a FIFO queue, so a slot is reused as late as
+ * possible and its generation wraps around as slowly as possible.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#include "slotmap_inline.h"
+
+/**
+ * @brief Builds the handle of a slot from its current generation.
+ */
+static SLOT_HANDLE slotmap_make_handle(SLOTMAP *map, uint16_t slot) {
+  return ((SLOT_HANDLE)map->generation[slot] << 16) | slot;
+}
+
+/**
+ * @brief Returns the packed position referred to by a handle, or -1.
+ */
+static int slotmap_lookup(SLOTMAP *map, SLOT_HANDLE handle) {
+  uint16_t slot = handle & 0xFFFF;
+
+  if (!map || slot >= map->capacity || map->slot_index[slot] == SLOT_FREE ||
+      map->generation[slot] != (uint16_t)(handle >> 16)) {
+    return -1;
+  }
+
+  return map->slot_index[slot];
+}
+
+/**
+ * @brief Returns a slot to the free queue and invalidates its handles.
+ */
+static void slotmap_release_slot(SLOTMAP *map, uint16_t slot) {
+  map->slot_index[slot] = SLOT_FREE;
+
+  // Generation 0 is skipped so that no handle is ever SLOT_HANDLE_NONE
+  if (++map->generation[slot] == 0) {
+    map->generation[slot] = 1;
+  }
+
+  slot_queue_push(&map->free_slots, slot);
+}
+
+/**
+ * @brief Creates an empty slot map.
+ *
+ * @param capacity Maximum number of items, up to SLOTMAP_MAX_CAPACITY.
+ * @return Pointer to the created SLOTMAP or NULL on failure.
+ */
+SLOTMAP *slotmap_create(int capacity) {
+  SLOTMAP *new_map = NULL;
+
+  if (capacity <= 0 || capacity > SLOTMAP_MAX_CAPACITY) {
+    return NULL;
+  }
+
+  new_map = (SLOTMAP *)malloc(sizeof(SLOTMAP));
+  if (!new_map) {
+    return NULL;
+  }
+
+  slot_entry_list_init(&new_map->entries,
+                       (SLOT_ENTRY *)calloc(capacity, sizeof(SLOT_ENTRY)), capacity);
+  slot_queue_init(&new_map->free_slots,
+                  (uint16_t *)calloc(capacity, sizeof(uint16_t)), capacity);
+  new_map->slot_index = (uint16_t *)calloc(capacity, sizeof(uint16_t));
+  new_map->generation = (uint16_t *)calloc(capacity, sizeof(uint16_t));
+  if (!new_map->entries.items || !new_map->free_slots.items ||
+      !new_map->slot_index || !new_map->generation) {
+    slotmap_destroy(new_map);
+    return NULL;
+  }
+
+  new_map->capacity = capacity;
+
+  for (int slot = 0; slot < capacity; slot++) {
+    new_map->slot_index[slot] = SLOT_FREE;
+    new_map->generation[slot] = 1;
+    slot_queue_push(&new_map->free_slots, (uint16_t)slot);
+  }
+
+  return new_map;
+}
+
+/**
+ * @brief Destroys the slot map and frees its memory.
+ *
+ * The stored items are owned by the caller and are not freed.
+ *
+ * @param map Pointer to the SLOTMAP to destroy.
+ * @return OK on success, ERROR if map is NULL.
+ */
+STATUS slotmap_destroy(SLOTMAP *map) {
+  if (!map) {
+    return ERROR;
+  }
+
+  free(map->entries.items);
+  free(map->free_slots.items);
+  free(map->slot_index);
+  free(map->generation);
+  free(map);
+
+  return OK;
+}
+
+/**
+ * @brief Stores an item at the end of the packed array.
+ *
+ * @param map Pointer to the SLOTMAP.
+ * @param item Item to store (must not be NULL).
+ * @return Handle of the item, or SLOT_HANDLE_NONE if the map is full.
+ */
+SLOT_HANDLE slotmap_insert(SLOTMAP *map, void *item) {
+  SLOT_ENTRY entry;
+
+  if (!map || !item || slot_entry_list_is_full(&map->entries) ||
+      slot_queue_pop(&map->free_slots, &entry.slot) == ERROR) {
+    return SLOT_HANDLE_NONE;
+  }
+
+  entry.item = item;
+  map->slot_index[entry.slot] = (uint16_t)slot_entry_list_size(&map->entries);
+  slot_entry_list_push(&map->entries, entry);
+
+  return slotmap_make_handle(map, entry.slot);
+}
+
+/**
+ * @brief Removes the item referred to by a handle.
+ *
+ * @param map Pointer to the SLOTMAP.
+ * @param handle Handle returned by slotmap_insert().
+ * @return The removed item, or NULL if the handle is stale.
+ */
+void *slotmap_remove(SLOTMAP *map, SLOT_HANDLE handle) {
+  int i = slotmap_lookup(map, handle);
+
+  if (i < 0) {
+    return NULL;
+  }
+
+  return slotmap_remove_at(map, i);
+}
+
+/**
+ * @brief Gets the item referred to by a handle.
+ *
+ * @param map Pointer to the SLOTMAP.
+ * @param handle Handle returned by slotmap_insert().
+ * @return The item, or NULL if the handle is stale or the item was cleared.
+ */
+void *slotmap_get(SLOTMAP *map, SLOT_HANDLE handle) {
+  int i = slotmap_lookup(map, handle);
+
+  if (i < 0) {
+    return NULL;
+  }
+
+  return slot_entry_list_at(&map->entries, i)->item;
+}
+
+/**
+ * @brief Gets the packed position of the item referred to by a handle.
+ *
+ * The position stays valid until the packed array is reordered by a
+ * removal or slotmap_compact().
+ *
+ * @param map Pointer to the SLOTMAP.
+ * @param handle Handle returned by slotmap_insert().
+ * @return Position in the packed array, or -1 if the handle is stale or the item was cleared.
+ */
+int slotmap_index_of(SLOTMAP *map, SLOT_HANDLE handle) {
+  int i = slotmap_lookup(map, handle);
+
+  if (i < 0 || !slot_entry_list_at(&map->entries, i)->item) {
+    return -1;
+  }
+
+  return i;
+}
+
+/**
+ * @brief Gets the number of entries in the packed array.
+ *
+ * @param map Pointer to the SLOTMAP.
+ * @return Number of entries (tombstones included), or 0 if map is NULL.
+ */
+int slotmap_size(SLOTMAP *map) {
+  if (!map) {
+    return 0;
+  }
+
+  return slot_entry_list_size(&map->entries);
+}
+
+/**
+ * @brief Gets the item at position i of the packed array.
+ *
+ * @param map Pointer to the SLOTMAP.
+ * @param i Position in the packed array.
+ * @return The item, or NULL if the position is invalid or a tombstone.
+ */
+void *slotmap_get_at(SLOTMAP *map, int i) {
+  if (!map || i < 0 || i >= map->entries.size) {
+    return NULL;
+  }
+
+  return slot_entry_list_at(&map->entries, i)->item;
+}
+
+/**
+ * @brief Gets the handle of the item at position i of the packed array.
+ *
+ * @param map Pointer to the SLOTMAP.
+ * @param i Position in the packed array.
+ * @return Handle of the item, or SLOT_HANDLE_NONE if the position is invalid.
+ */
+SLOT_HANDLE slotmap_handle_at(SLOTMAP *map, int i) {
+  if (!map || i < 0 || i >= map->entries.size || !map->entries.items[i].item) {
+    return SLOT_HANDLE_NONE;
+  }
+
+  return slotmap_make_handle(map, map->entries.items[i].slot);
+}
+
+/**
+ * @brief Removes the item at position i of the packed array.
+ *
+ * The last entry is moved into the freed position, so removal takes
+ * constant time but does not keep the order.
+ *
+ * @param map Pointer to the SLOTMAP.
+ * @param i Position in the packed array.
+ * @return The removed item, or NULL if the position is invalid.
+ */
+void *slotmap_remove_at(SLOTMAP *map, int i) {
+  SLOT_ENTRY removed;
+
+  if (!map || i < 0 || i >= map->entries.size) {
+    return NULL;
+  }
+
+  removed = slot_entry_list_remove_at(&map->entries, i);
+  slotmap_release_slot(map, removed.slot);
+
+  // The former last entry now sits at i
+  if (i < map->entries.size) {
+    map->slot_index[map->entries.items[i].slot] = (uint16_t)i;
+  }
+
+  return removed.item;
+}
+
+/**
+ * @brief Empties position i of the packed array, leaving a tombstone.
+ *
+ * Positions of the other items do not change until slotmap_compact() is
+ * called, so the packed array can be cleared while it is being iterated.
+ * The handle of the cleared item already resolves to NULL.
+ *
+ * @param map Pointer to the SLOTMAP.
+ * @param i Position in the packed array.
+ * @return The cleared item, or NULL if the position is invalid.
+ */
+void *slotmap_clear_at(SLOTMAP *map, int i) {
+  void *item = NULL;
+
+  if (!map || i < 0 || i >= map->entries.size) {
+    return NULL;
+  }
+
+  item = map->entries.items[i].item;
+  map->entries.items[i].item = NULL;
+
+  return item;
+}
+
+/**
+ * @brief Removes every tombstone left by slotmap_clear_at().
+ *
+ * The remaining items keep their relative order and their handles.
+ *
+ * @param map Pointer to the SLOTMAP.
+ * @return OK on success, ERROR if map is NULL.
+ */
+STATUS slotmap_compact(SLOTMAP *map) {
+  SLOT_ENTRY *items = NULL;
+  int n = 0;
+
+  if (!map) {
+    return ERROR;
+  }
+
+  items = map->entries.items;
+
+  for (int i = 0; i < map->entries.size; i++) {
+    if (items[i].item == NULL) {
+      slotmap_release_slot(map, items[i].slot);
+      continue;
+    }
+
+    items[n] = items[i];
+    map->slot_index[items[n].slot] = (uint16_t)n;
+    n++;
+  }
+
+  map->entries.size = n;
+
+  return OK;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file sprite.c
+ * @brief Implementation of the shared sprite descriptors.
+ *
+ * The descriptors live in a static table indexed by SPRITE_ID. The bitmaps
+ * are owned by the game, which registers them once they are loaded.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#include "sprite_inline.h"
+
+SPRITE sprite_table[NUM_SPRITES];
+
+/**
+ * @brief Registers the bitmap and frame size of a sprite.
+ *
+ * @param id Sprite to describe.
+ * @param bitmap Sprite sheet, or NULL when only the size is used (headless
+ *               games). It must outlive every entity using the sprite.
+ * @param width Width of one frame.
+ * @param height Height of one frame.
+ * @return OK on success, ERROR if id is invalid.
+ */
+STATUS sprite_register(SPRITE_ID id, ALLEGRO_BITMAP *bitmap, int width, int height) {
+  if (id >= NUM_SPRITES) {
+    return ERROR;
+  }
+
+  sprite_table[id].bitmap = bitmap;
+  sprite_table[id].width = width;
+  sprite_table[id].height = height;
+
+  return OK;
+}
+
+/**
+ * @brief Gets the bitmap of a sprite.
+ *
+ * @param id Sprite to query.
+ * @return The bitmap, or NULL if id is invalid or not registered.
+ */
+ALLEGRO_BITMAP *sprite_get_bitmap(SPRITE_ID id) {
+  if (id >= NUM_SPRITES) {
+    return NULL;
+  }
+
+  return sprite_table[id].bitmap;
+}
+
+/**
+ * @brief Gets the frame width of a sprite.
+ *
+ * @param id Sprite to query.
+ * @return Width of one frame, or 0 if id is invalid.
+ */
+int sprite_get_width(SPRITE_ID id) {
+  if (id >= NUM_SPRITES) {
+    return 0;
+  }
+
+  return sprite_table[id].width;
+}
+
+/**
+ * @brief Gets the frame height of a sprite.
+ *
+ * @param id Sprite to query.
+ * @return Height of one frame, or 0 if id is invalid.
+ */
+int sprite_get_height(SPRITE_ID id) {
+  if (id >= NUM_SPRITES) {
+    return 0;
+  }
+
+  return sprite_table[id].height;
+}
+
+/**
+ * @brief Draws one frame of a sprite.
+ *
+ * @param id Sprite to draw.
+ * @param frame_x Column of the frame in the sprite sheet.
+ * @param frame_y Row of the frame in the sprite sheet.
+ * @param x X-coordinate on screen.
+ * @param y Y-coordinate on screen.
+ * @return OK on success, ERROR if the sprite is not registered.
+ */
+STATUS sprite_draw(SPRITE_ID id, int frame_x, int frame_y, FIXED x, FIXED y) {
+  SPRITE *sprite = NULL;
+
+  if (id >= NUM_SPRITES || !sprite_table[id].bitmap) {
+    return ERROR;
+  }
+
+  sprite = &sprite_table[id];
+  al_draw_bitmap_region(sprite->bitmap, frame_x * sprite->width, frame_y * sprite->height,
+                        sprite->width, sprite->height, FIXED_TO_FLOAT(x), FIXED_TO_FLOAT(y), 0);
+
+  return OK;
+}
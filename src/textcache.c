@@ -0,0 +1,232 @@
+/**
+ * @file textcache.c
+ * @brief Implementation of the cache of pre-rendered text lines.
+ *
+ * Each slot remembers the text and colour its bitmap was rendered with.
+ * The bitmap covers the bounding box of the glyphs, which may start left
+ * of or below the pen position, so the offset of the box is kept too.
+ * Lines are rendered with the default premultiplied blender onto a clear
+ * bitmap, so blitting them gives the same pixels as drawing the text.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#include "textcache.h"
+
+/**
+ * @brief Cached rendering of one line.
+ */
+typedef struct {
+  char text[TEXT_CACHE_MAX_TEXT]; ///< Text the bitmap holds
+  ALLEGRO_COLOR color;            ///< Colour the bitmap was rendered with
+  ALLEGRO_BITMAP *bitmap;         ///< Rendered line, or NULL if the slot is empty
+  int box_x, box_y;               ///< Offset of the bitmap from the pen position
+  int advance;                    ///< Width of the line, used for alignment
+  int value;                      ///< Number shown, for textcache_draw_number()
+  bool has_value;                 ///< Whether value is meaningful
+} TEXT_LINE;
+
+/**
+ * @struct _textcache
+ * @brief Font plus the cached lines.
+ */
+struct _textcache {
+  ALLEGRO_FONT *font; ///< Font of every line (not owned)
+  TEXT_LINE *lines;   ///< One entry per slot
+  int num_slots;      ///< Number of entries in lines
+};
+
+/**
+ * @brief Renders a line into its slot, replacing the previous bitmap.
+ *
+ * @return OK on success, ERROR if the bitmap cannot be created.
+ */
+static STATUS textcache_render(TEXT_CACHE *cache, TEXT_LINE *line, ALLEGRO_COLOR color,
+                               const char *text) {
+  ALLEGRO_STATE state;
+  int bbx, bby, bbw, bbh;
+
+  if (line->bitmap) {
+    al_destroy_bitmap(line->bitmap);
+    line->bitmap = NULL;
+  }
+
+  snprintf(line->text, sizeof(line->text), "%s", text);
+  line->color = color;
+  line->advance = al_get_text_width(cache->font, line->text);
+
+  al_get_text_dimensions(cache->font, line->text, &bbx, &bby, &bbw, &bbh);
+  line->box_x = bbx;
+  line->box_y = bby;
+
+  // Nothing to draw (empty or blank text)
+  if (bbw <= 0 || bbh <= 0) {
+    return OK;
+  }
+
+  line->bitmap = al_create_bitmap(bbw, bbh);
+  if (!line->bitmap) {
+    return ERROR;
+  }
+
+  al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP);
+  al_set_target_bitmap(line->bitmap);
+  al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+  al_draw_text(cache->font, color, -bbx, -bby, 0, line->text);
+  al_restore_state(&state);
+
+  return OK;
+}
+
+/**
+ * @brief Blits the bitmap of a slot with the alignment of al_draw_text().
+ */
+static void textcache_blit(const TEXT_LINE *line, float x, float y, int flags) {
+  if (!line->bitmap) {
+    return;
+  }
+
+  if (flags & ALLEGRO_ALIGN_CENTER) {
+    x -= line->advance / 2.0f;
+  } else if (flags & ALLEGRO_ALIGN_RIGHT) {
+    x -= line->advance;
+  }
+
+  al_draw_bitmap(line->bitmap, x + line->box_x, y + line->box_y, 0);
+}
+
+/**
+ * @brief Creates an empty text cache.
+ *
+ * @param font Font used for every line. It must outlive the cache.
+ * @param num_slots Number of lines the cache can hold.
+ * @return Pointer to the created TEXT_CACHE or NULL on failure.
+ */
+TEXT_CACHE *textcache_create(ALLEGRO_FONT *font, int num_slots) {
+  TEXT_CACHE *new_cache = NULL;
+
+  if (!font || num_slots <= 0) {
+    return NULL;
+  }
+
+  new_cache = (TEXT_CACHE *)malloc(sizeof(TEXT_CACHE));
+  if (!new_cache) {
+    return NULL;
+  }
+
+  new_cache->lines = (TEXT_LINE *)calloc(num_slots, sizeof(TEXT_LINE));
+  if (!new_cache->lines) {
+    free(new_cache);
+    return NULL;
+  }
+
+  new_cache->font = font;
+  new_cache->num_slots = num_slots;
+
+  return new_cache;
+}
+
+/**
+ * @brief Destroys the cache and frees its memory.
+ *
+ * @param cache Pointer to the TEXT_CACHE to destroy.
+ * @return OK on success, ERROR if cache is NULL.
+ */
+STATUS textcache_destroy(TEXT_CACHE *cache) {
+  if (!cache) {
+    return ERROR;
+  }
+
+  for (int i = 0; i < cache->num_slots; i++) {
+    if (cache->lines[i].bitmap) {
+      al_destroy_bitmap(cache->lines[i].bitmap);
+    }
+  }
+
+  free(cache->lines);
+  free(cache);
+
+  return OK;
+}
+
+/**
+ * @brief Draws a line of text through a slot of the cache.
+ *
+ * The line is rendered again only if the slot last held another text or
+ * colour. A slot should be used for a single line of the screen, or the
+ * cache is rebuilt every time the lines sharing it alternate.
+ *
+ * @param cache Pointer to the TEXT_CACHE.
+ * @param slot Slot of the line, in [0, num_slots).
+ * @param color Colour of the text.
+ * @param x X-coordinate of the pen, as for al_draw_text().
+ * @param y Y-coordinate of the pen.
+ * @param flags ALLEGRO_ALIGN_LEFT, ALLEGRO_ALIGN_CENTER or ALLEGRO_ALIGN_RIGHT.
+ * @param text Text to draw; longer lines are cut to TEXT_CACHE_MAX_TEXT - 1 characters.
+ * @return OK on success, ERROR if an argument is invalid or the line cannot be rendered.
+ */
+STATUS textcache_draw(TEXT_CACHE *cache, int slot, ALLEGRO_COLOR color, float x, float y,
+                      int flags, const char *text) {
+  TEXT_LINE *line = NULL;
+
+  if (!cache || slot < 0 || slot >= cache->num_slots || !text) {
+    return ERROR;
+  }
+
+  line = &cache->lines[slot];
+  if (line->has_value || strncmp(line->text, text, sizeof(line->text)) != 0 ||
+      memcmp(&line->color, &color, sizeof(color)) != 0) {
+    if (textcache_render(cache, line, color, text) == ERROR) {
+      return ERROR;
+    }
+    line->has_value = false;
+  }
+
+  textcache_blit(line, x, y, flags);
+
+  return OK;
+}
+
+/**
+ * @brief Draws a formatted number through a slot of the cache.
+ *
+ * The number is only formatted and rendered when it differs from the one
+ * the slot shows, so an unchanged score costs neither snprintf() nor text
+ * drawing. The format must stay the same for a given slot.
+ *
+ * @param cache Pointer to the TEXT_CACHE.
+ * @param slot Slot of the line, in [0, num_slots).
+ * @param color Colour of the text.
+ * @param x X-coordinate of the pen, as for al_draw_text().
+ * @param y Y-coordinate of the pen.
+ * @param flags ALLEGRO_ALIGN_LEFT, ALLEGRO_ALIGN_CENTER or ALLEGRO_ALIGN_RIGHT.
+ * @param format printf() format with a single int conversion.
+ * @param value Number to show.
+ * @return OK on success, ERROR if an argument is invalid or the line cannot be rendered.
+ */
+STATUS textcache_draw_number(TEXT_CACHE *cache, int slot, ALLEGRO_COLOR color, float x, float y,
+                             int flags, const char *format, int value) {
+  TEXT_LINE *line = NULL;
+
+  if (!cache || slot < 0 || slot >= cache->num_slots || !format) {
+    return ERROR;
+  }
+
+  line = &cache->lines[slot];
+  if (!line->has_value || line->value != value ||
+      memcmp(&line->color, &color, sizeof(color)) != 0) {
+    char text[TEXT_CACHE_MAX_TEXT];
+
+    snprintf(text, sizeof(text), format, value);
+    if (textcache_render(cache, line, color, text) == ERROR) {
+      return ERROR;
+    }
+    line->value = value;
+    line->has_value = true;
+  }
+
+  textcache_blit(line, x, y, flags);
+
+  return OK;
+}
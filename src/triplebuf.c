@@ -0,0 +1,122 @@
+/**
+ * @file triplebuf.c
+ * @brief Implementation of the lock-free triple buffer.
+ *
+ * The word in between holds a slot index plus a flag telling whether the
+ * writer put it there after the reader's last acquire. Each side swaps its
+ * own slot with it in one atomic exchange. The exchanges are acquire-release,
+ * so everything the writer stored in a slot before publishing it is visible
+ * to the reader once it has acquired that slot.
+ *
+ * Author: RGiskard7
+ * Date: 13/11/2024
+ */
+
+#include "triplebuf.h"
+
+#define TRIPLEBUF_FRESH 4 ///< Set on middle when it holds an unread frame
+#define TRIPLEBUF_SLOT 3  ///< Mask of the slot index in middle
+
+/**
+ * @brief Initialises a triple buffer with no published frame.
+ *
+ * The writer starts with slot 0 and the reader with slot 1.
+ *
+ * @param buffer Pointer to the TRIPLE_BUFFER.
+ * @return OK on success, ERROR if buffer is NULL.
+ */
+STATUS triplebuf_init(TRIPLE_BUFFER *buffer) {
+  if (!buffer) {
+    return ERROR;
+  }
+
+  buffer->back = 0;
+  buffer->front = 1;
+  atomic_init(&buffer->middle, 2);
+
+  return OK;
+}
+
+/**
+ * @brief Slot the writer is filling.
+ *
+ * @param buffer Pointer to the TRIPLE_BUFFER.
+ * @return Index of the back slot, or -1 if buffer is NULL.
+ */
+int triplebuf_back(const TRIPLE_BUFFER *buffer) {
+  if (!buffer) {
+    return -1;
+  }
+
+  return buffer->back;
+}
+
+/**
+ * @brief Publishes the back slot and gives the writer a new one.
+ *
+ * Must only be called by the writer. The slot handed back may hold an
+ * older frame, published before but never acquired; the writer has to
+ * fill it completely again.
+ *
+ * @param buffer Pointer to the TRIPLE_BUFFER.
+ * @return Index of the new back slot, or -1 if buffer is NULL.
+ */
+int triplebuf_publish(TRIPLE_BUFFER *buffer) {
+  if (!buffer) {
+    return -1;
+  }
+
+  int old = atomic_exchange_explicit(&buffer->middle, buffer->back | TRIPLEBUF_FRESH,
+                                     memory_order_acq_rel);
+  buffer->back = old & TRIPLEBUF_SLOT;
+
+  return buffer->back;
+}
+
+/**
+ * @brief Whether a frame was published since the reader last acquired one.
+ *
+ * @param buffer Pointer to the TRIPLE_BUFFER.
+ * @return true if triplebuf_acquire() would return a new frame, false otherwise.
+ */
+bool triplebuf_fresh(TRIPLE_BUFFER *buffer) {
+  if (!buffer) {
+    return false;
+  }
+
+  return atomic_load_explicit(&buffer->middle, memory_order_acquire) & TRIPLEBUF_FRESH;
+}
+
+/**
+ * @brief Takes the latest published frame, if newer than the front slot.
+ *
+ * Must only be called by the reader. When nothing new was published the
+ * front slot is kept, so the reader can draw the same frame again.
+ *
+ * @param buffer Pointer to the TRIPLE_BUFFER.
+ * @return true if the front slot now holds a new frame, false otherwise.
+ */
+bool triplebuf_acquire(TRIPLE_BUFFER *buffer) {
+  if (!triplebuf_fresh(buffer)) {
+    return false;
+  }
+
+  int old = atomic_exchange_explicit(&buffer->middle, buffer->front, memory_order_acq_rel);
+  buffer->front = old & TRIPLEBUF_SLOT;
+
+  return true;
+}
+
+/**
+ * @brief Slot the reader is using.
+ *
+ * @param buffer Pointer to the TRIPLE_BUFFER.
+ * @return Index of the front slot, or -1 if buffer is NULL.
+ */
+int triplebuf_front(const TRIPLE_BUFFER *buffer) {
+  if (!buffer) {
+    return -1;
+  }
+
+  return buffer->front;
+}